@@ -16,7 +16,7 @@ public:
     };
 
     static std::shared_ptr<Assets::ObjectTexture> getObjectTexture(const std::string& name);
-    static bool loadImage(const std::string& path, const std::string& name, sf::Texture& texture);
+    static bool loadImage(const std::string& name, sf::Texture& texture); // name already holds the directory
     static void loadDirectoryElements(const std::string& path);
     static std::vector<std::string> getDirectoryContents(const std::string &path);
     
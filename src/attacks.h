@@ -0,0 +1,151 @@
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include "position.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#define ATTACKS_PEXT_AVAILABLE
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define ATTACKS_PEXT_AVAILABLE
+#endif
+
+// attack masks of the pieces that jump, built by the compiler
+
+class LeaperAttacks
+{
+public:
+    struct Table
+    {
+        uint64_t masks[64];
+    };
+
+    static constexpr int knightSteps[8][2] = { { 1, 2 }, { 2, 1 }, { 2, -1 }, { 1, -2 }, { -1, -2 }, { -2, -1 }, { -2, 1 }, { -1, 2 } };
+    static constexpr int kingSteps[8][2] = { { 0, 1 }, { 1, 1 }, { 1, 0 }, { 1, -1 }, { 0, -1 }, { -1, -1 }, { -1, 0 }, { -1, 1 } };
+    static constexpr int whitePawnSteps[2][2] = { { -1, 1 }, { 1, 1 } };
+    static constexpr int blackPawnSteps[2][2] = { { -1, -1 }, { 1, -1 } };
+
+    template <int count>
+    static constexpr LeaperAttacks::Table build(const int (&steps)[count][2])
+    {
+        LeaperAttacks::Table table{};
+        for (int square = 0; square < 64; square++)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                int file = square % 8 + steps[i][0];
+                int rank = square / 8 + steps[i][1];
+                if (file >= 0 && file < 8 && rank >= 0 && rank < 8)
+                {
+                    table.masks[square] |= 1ULL << (rank * 8 + file);
+                }
+            }
+        }
+        return table;
+    }
+};
+
+// precomputed attack sets, Attacks::init() has to run once before any slider lookup
+// sliders use fancy magic bitboards, or PEXT indexing when the cpu has BMI2
+
+class Attacks
+{
+public:
+    struct Magic
+    {
+        uint64_t mask; // relevant occupancy, the board edges are left out
+        uint64_t magic;
+        uint64_t* attacks; // this square's slice of the shared table
+        uint8_t shift;
+
+        unsigned getIndex(uint64_t occupied) const;
+    };
+
+    static void init(bool allowPext = true);
+    static bool cpuHasBmi2();
+    static bool isUsingPext() { return Attacks::usePext; }
+
+    static uint64_t getRookAttacks(uint8_t square, uint64_t occupied);
+    static uint64_t getBishopAttacks(uint8_t square, uint64_t occupied);
+    static uint64_t getQueenAttacks(uint8_t square, uint64_t occupied);
+    static uint64_t getKnightAttacks(uint8_t square) { return Attacks::knightTable.masks[square]; }
+    static uint64_t getKingAttacks(uint8_t square) { return Attacks::kingTable.masks[square]; }
+    static uint64_t getPawnAttacks(Position::Color color, uint8_t square) { return Attacks::pawnTables[color].masks[square]; }
+    static uint64_t getPawnAttacks(Position::Color color, uint64_t pawns); // every pawn of the mask at once
+    static uint64_t getBetween(uint8_t from, uint8_t to) { return Attacks::betweenMasks[from][to]; } // empty if not on one line
+
+    static uint64_t getSlidingAttacks(bool rook, uint8_t square, uint64_t occupied); // slow ray walk, only for building tables
+
+#ifdef ATTACKS_PEXT_AVAILABLE
+    static uint64_t pext(uint64_t value, uint64_t mask); // inlined when built with BMI2 enabled, a call otherwise
+#endif
+
+    static constexpr LeaperAttacks::Table knightTable = LeaperAttacks::build(LeaperAttacks::knightSteps);
+    static constexpr LeaperAttacks::Table kingTable = LeaperAttacks::build(LeaperAttacks::kingSteps);
+    static constexpr LeaperAttacks::Table pawnTables[2] = { LeaperAttacks::build(LeaperAttacks::whitePawnSteps), LeaperAttacks::build(LeaperAttacks::blackPawnSteps) };
+
+private:
+    static bool usePext;
+    static Attacks::Magic rookMagics[64];
+    static Attacks::Magic bishopMagics[64];
+    static uint64_t rookTable[0x19000];
+    static uint64_t bishopTable[0x1480];
+    static uint64_t betweenMasks[64][64];
+
+    static void initMagics(bool rook, Attacks::Magic magics[64], uint64_t* table);
+    static void initBetween();
+};
+
+#if defined(ATTACKS_PEXT_AVAILABLE) && defined(__BMI2__)
+inline uint64_t Attacks::pext(uint64_t value, uint64_t mask)
+{
+    return _pext_u64(value, mask);
+}
+#endif
+
+static_assert(Attacks::knightTable.masks[0] == 0x20400ULL, "knight on a1 attacks b3 and c2");
+static_assert(Attacks::kingTable.masks[63] == 0x40C0000000000000ULL, "king on h8 attacks g8, g7 and h7");
+static_assert(Attacks::pawnTables[Position::WHITE].masks[12] == 0x280000ULL && Attacks::pawnTables[Position::BLACK].masks[12] == 0x28ULL, "pawns on e2 attack d3/f3 or d1/f1");
+
+inline unsigned Attacks::Magic::getIndex(uint64_t occupied) const
+{
+#ifdef ATTACKS_PEXT_AVAILABLE
+    if (Attacks::usePext)
+    {
+        return (unsigned)Attacks::pext(occupied, this->mask);
+    }
+#endif
+    return (unsigned)(((occupied & this->mask) * this->magic) >> this->shift);
+}
+
+inline uint64_t Attacks::getRookAttacks(uint8_t square, uint64_t occupied)
+{
+    const Attacks::Magic& magic = Attacks::rookMagics[square];
+    return magic.attacks[magic.getIndex(occupied)];
+}
+
+inline uint64_t Attacks::getBishopAttacks(uint8_t square, uint64_t occupied)
+{
+    const Attacks::Magic& magic = Attacks::bishopMagics[square];
+    return magic.attacks[magic.getIndex(occupied)];
+}
+
+inline uint64_t Attacks::getPawnAttacks(Position::Color color, uint64_t pawns)
+{
+    const uint64_t notFileA = ~0x0101010101010101ULL;
+    const uint64_t notFileH = ~0x8080808080808080ULL;
+
+    if (color == Position::WHITE)
+    {
+        return ((pawns & notFileA) << 7) | ((pawns & notFileH) << 9);
+    }
+    return ((pawns & notFileA) >> 9) | ((pawns & notFileH) >> 7);
+}
+
+inline uint64_t Attacks::getQueenAttacks(uint8_t square, uint64_t occupied)
+{
+    return Attacks::getRookAttacks(square, occupied) | Attacks::getBishopAttacks(square, occupied);
+}
+
+#endif
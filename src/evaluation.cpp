@@ -0,0 +1,280 @@
+#include "evaluation.h"
+
+const int Evaluation::pieceValues[6] = { 500, 320, 330, 0, 900, 100 };
+
+const int Evaluation::middleGameTables[6][64] =
+{
+    { // rook
+         0,  0,  0,  0,  0,  0,  0,  0,
+         5, 10, 10, 10, 10, 10, 10,  5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+         0,  0,  0,  5,  5,  0,  0,  0
+    },
+    { // knight
+        -50,-40,-30,-30,-30,-30,-40,-50,
+        -40,-20,  0,  0,  0,  0,-20,-40,
+        -30,  0, 10, 15, 15, 10,  0,-30,
+        -30,  5, 15, 20, 20, 15,  5,-30,
+        -30,  0, 15, 20, 20, 15,  0,-30,
+        -30,  5, 10, 15, 15, 10,  5,-30,
+        -40,-20,  0,  5,  5,  0,-20,-40,
+        -50,-40,-30,-30,-30,-30,-40,-50
+    },
+    { // bishop
+        -20,-10,-10,-10,-10,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5, 10, 10,  5,  0,-10,
+        -10,  5,  5, 10, 10,  5,  5,-10,
+        -10,  0, 10, 10, 10, 10,  0,-10,
+        -10, 10, 10, 10, 10, 10, 10,-10,
+        -10,  5,  0,  0,  0,  0,  5,-10,
+        -20,-10,-10,-10,-10,-10,-10,-20
+    },
+    { // king, stays behind its pawns
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -20,-30,-30,-40,-40,-30,-30,-20,
+        -10,-20,-20,-20,-20,-20,-20,-10,
+         20, 20,  0,  0,  0,  0, 20, 20,
+         20, 30, 10,  0,  0, 10, 30, 20
+    },
+    { // queen
+        -20,-10,-10, -5, -5,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5,  5,  5,  5,  0,-10,
+         -5,  0,  5,  5,  5,  5,  0, -5,
+          0,  0,  5,  5,  5,  5,  0, -5,
+        -10,  5,  5,  5,  5,  5,  0,-10,
+        -10,  0,  5,  0,  0,  0,  0,-10,
+        -20,-10,-10, -5, -5,-10,-10,-20
+    },
+    { // pawn
+         0,  0,  0,  0,  0,  0,  0,  0,
+        50, 50, 50, 50, 50, 50, 50, 50,
+        10, 10, 20, 30, 30, 20, 10, 10,
+         5,  5, 10, 25, 25, 10,  5,  5,
+         0,  0,  0, 20, 20,  0,  0,  0,
+         5, -5,-10,  0,  0,-10, -5,  5,
+         5, 10, 10,-20,-20, 10, 10,  5,
+         0,  0,  0,  0,  0,  0,  0,  0
+    }
+};
+
+const int Evaluation::endGameTables[6][64] =
+{
+    { // rook
+         0,  0,  0,  0,  0,  0,  0,  0,
+         5, 10, 10, 10, 10, 10, 10,  5,
+         0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0,
+         0,  0,  0,  0,  0,  0,  0,  0
+    },
+    { // knight
+        -50,-40,-30,-30,-30,-30,-40,-50,
+        -40,-20,  0,  0,  0,  0,-20,-40,
+        -30,  0, 10, 15, 15, 10,  0,-30,
+        -30,  5, 15, 20, 20, 15,  5,-30,
+        -30,  0, 15, 20, 20, 15,  0,-30,
+        -30,  5, 10, 15, 15, 10,  5,-30,
+        -40,-20,  0,  5,  5,  0,-20,-40,
+        -50,-40,-30,-30,-30,-30,-40,-50
+    },
+    { // bishop
+        -20,-10,-10,-10,-10,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5, 10, 10,  5,  0,-10,
+        -10,  5,  5, 10, 10,  5,  5,-10,
+        -10,  0, 10, 10, 10, 10,  0,-10,
+        -10, 10, 10, 10, 10, 10, 10,-10,
+        -10,  5,  0,  0,  0,  0,  5,-10,
+        -20,-10,-10,-10,-10,-10,-10,-20
+    },
+    { // king, walks to the middle once the queens are gone
+        -50,-40,-30,-20,-20,-30,-40,-50,
+        -30,-20,-10,  0,  0,-10,-20,-30,
+        -30,-10, 20, 30, 30, 20,-10,-30,
+        -30,-10, 30, 40, 40, 30,-10,-30,
+        -30,-10, 30, 40, 40, 30,-10,-30,
+        -30,-10, 20, 30, 30, 20,-10,-30,
+        -30,-30,  0,  0,  0,  0,-30,-30,
+        -50,-30,-30,-30,-30,-30,-30,-50
+    },
+    { // queen
+        -20,-10,-10, -5, -5,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5,  5,  5,  5,  0,-10,
+         -5,  0,  5,  5,  5,  5,  0, -5,
+          0,  0,  5,  5,  5,  5,  0, -5,
+        -10,  5,  5,  5,  5,  5,  0,-10,
+        -10,  0,  5,  0,  0,  0,  0,-10,
+        -20,-10,-10, -5, -5,-10,-10,-20
+    },
+    { // pawn, the closer to promotion the better
+         0,  0,  0,  0,  0,  0,  0,  0,
+        80, 80, 80, 80, 80, 80, 80, 80,
+        50, 50, 50, 50, 50, 50, 50, 50,
+        30, 30, 30, 30, 30, 30, 30, 30,
+        20, 20, 20, 20, 20, 20, 20, 20,
+        10, 10, 10, 10, 10, 10, 10, 10,
+        10, 10, 10, 10, 10, 10, 10, 10,
+         0,  0,  0,  0,  0,  0,  0,  0
+    }
+};
+
+int Evaluation::getExchangeValue(const Position& position, Move move)
+{
+    // swap list: gains[d] is what the side making capture d has won so far if the exchange stops after it,
+    // it is then folded back from the end, each side only takes when that beats standing pat
+
+    if (move.getFlag() == Move::CASTLING)
+    {
+        return 0;
+    }
+
+    uint8_t from = move.getFrom();
+    uint8_t to = move.getTo();
+    uint64_t occupied = position.getOccupancy() ^ Position::squareMask(from);
+    int gains[32];
+
+    Position::PieceType victim = position.getPieceTypeOn(to);
+    gains[0] = victim == Position::NO_PIECE_TYPE ? 0 : Evaluation::pieceValues[victim];
+    int onTarget = Evaluation::pieceValues[position.getPieceTypeOn(from)];
+    if (move.getFlag() == Move::EN_PASSANT)
+    {
+        gains[0] = Evaluation::pieceValues[Position::PAWN];
+        occupied ^= Position::squareMask(to ^ 8);
+    }
+    else if (move.getFlag() == Move::PROMOTION)
+    {
+        onTarget = Evaluation::pieceValues[move.getPromotion()];
+        gains[0] += onTarget - Evaluation::pieceValues[Position::PAWN];
+    }
+
+    const uint64_t diagonal = position.pieces[Position::WHITE][Position::BISHOP] | position.pieces[Position::BLACK][Position::BISHOP]
+        | position.pieces[Position::WHITE][Position::QUEEN] | position.pieces[Position::BLACK][Position::QUEEN];
+    const uint64_t straight = position.pieces[Position::WHITE][Position::ROOK] | position.pieces[Position::BLACK][Position::ROOK]
+        | position.pieces[Position::WHITE][Position::QUEEN] | position.pieces[Position::BLACK][Position::QUEEN];
+    const Position::PieceType cheapestFirst[6] = { Position::PAWN, Position::KNIGHT, Position::BISHOP, Position::ROOK, Position::QUEEN, Position::KING };
+
+    uint64_t attackers = MoveGen::getAttackersTo(position, to, occupied) & occupied;
+    Position::Color side = Position::getOpposingColor((Position::Color)position.sideToMove);
+    int depth = 0;
+    while (depth < 31)
+    {
+        uint64_t ours = attackers & position.getOccupancy(side);
+        if (!ours)
+        {
+            break;
+        }
+
+        Position::PieceType type = Position::KING;
+        uint64_t attacker = 0;
+        for (Position::PieceType candidate : cheapestFirst)
+        {
+            attacker = ours & position.pieces[side][candidate];
+            if (attacker)
+            {
+                type = candidate;
+                break;
+            }
+        }
+        if (type == Position::KING && (attackers & position.getOccupancy(Position::getOpposingColor(side))))
+        {
+            break; // the king can't take a defended piece
+        }
+
+        depth++;
+        gains[depth] = onTarget - gains[depth - 1];
+        onTarget = type == Position::KING ? Evaluation::KING_EXCHANGE_VALUE : Evaluation::pieceValues[type];
+        if (type == Position::PAWN && (Position::getRank(to) == 0 || Position::getRank(to) == 7)) // recaptures promoting
+        {
+            gains[depth] += Evaluation::pieceValues[Position::QUEEN] - Evaluation::pieceValues[Position::PAWN];
+            onTarget = Evaluation::pieceValues[Position::QUEEN];
+        }
+
+        // lifting the attacker may uncover a slider behind it on the same line
+        occupied ^= Position::squareMask(Position::lsb(attacker));
+        if (type == Position::PAWN || type == Position::BISHOP || type == Position::QUEEN)
+        {
+            attackers |= Attacks::getBishopAttacks(to, occupied) & diagonal;
+        }
+        if (type == Position::ROOK || type == Position::QUEEN)
+        {
+            attackers |= Attacks::getRookAttacks(to, occupied) & straight;
+        }
+        attackers &= occupied;
+        side = Position::getOpposingColor(side);
+    }
+
+    while (depth > 0)
+    {
+        gains[depth - 1] = -(-gains[depth - 1] > gains[depth] ? -gains[depth - 1] : gains[depth]);
+        depth--;
+    }
+    return gains[0];
+}
+
+bool Evaluation::see(const Position& position, Move move, int threshold)
+{
+    // most calls are answered without the swap list: taking something worth less than the threshold can't reach it,
+    // and taking something worth enough to lose the capturing piece on top always does
+
+    if (move.getFlag() == Move::NORMAL)
+    {
+        Position::PieceType victim = position.getPieceTypeOn(move.getTo());
+        int captured = victim == Position::NO_PIECE_TYPE ? 0 : Evaluation::pieceValues[victim];
+        if (captured < threshold)
+        {
+            return false;
+        }
+        Position::PieceType attacker = position.getPieceTypeOn(move.getFrom());
+        if (attacker != Position::KING && captured - Evaluation::pieceValues[attacker] >= threshold)
+        {
+            return true;
+        }
+    }
+    return Evaluation::getExchangeValue(position, move) >= threshold;
+}
+
+int Evaluation::evaluate(const Position& position)
+{
+    // phase counts minor pieces 1, rooks 2 and queens 4, from MAX_PHASE at the start down to 0 with only pawns left
+
+    const int phaseWeights[6] = { 2, 1, 1, 0, 4, 0 };
+
+    int middleGame = 0;
+    int endGame = 0;
+    int phase = 0;
+    for (int color = Position::WHITE; color <= Position::BLACK; color++)
+    {
+        int sign = color == Position::WHITE ? 1 : -1;
+        uint8_t flip = color == Position::WHITE ? 56 : 0;
+        for (int type = Position::ROOK; type < Position::NO_PIECE_TYPE; type++)
+        {
+            phase += phaseWeights[type] * position.pieceCounts[color][type];
+            uint64_t pieces = position.pieces[color][type];
+            while (pieces)
+            {
+                uint8_t square = Position::popLsb(pieces) ^ flip;
+                middleGame += sign * (Evaluation::pieceValues[type] + Evaluation::middleGameTables[type][square]);
+                endGame += sign * (Evaluation::pieceValues[type] + Evaluation::endGameTables[type][square]);
+            }
+        }
+    }
+    if (phase > Evaluation::MAX_PHASE)
+    {
+        phase = Evaluation::MAX_PHASE; // early promotions
+    }
+
+    int score = (middleGame * phase + endGame * (Evaluation::MAX_PHASE - phase)) / Evaluation::MAX_PHASE;
+    return position.sideToMove == Position::WHITE ? score : -score;
+}
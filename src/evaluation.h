@@ -0,0 +1,30 @@
+#ifndef EVALUATION_H
+#define EVALUATION_H
+
+#include "movegen.h"
+
+// static evaluation: material plus piece square tables, blended between middle game and end game by the material left
+
+class Evaluation
+{
+public:
+    static const int pieceValues[6]; // in Position::PieceType order, the king counts 0
+
+    static int evaluate(const Position& position); // centipawns from the side to move's point of view
+
+    // static exchange evaluation: what the side to move ends up with in material if both sides keep recapturing on the
+    // move's target cell with their least valuable piece and either may stop when it suits them
+    // pins are not looked at, sliders behind the pieces that took part join in as they are uncovered
+    static int getExchangeValue(const Position& position, Move move);
+    static bool see(const Position& position, Move move, int threshold); // whether the exchange wins at least threshold
+
+private:
+    static const int MAX_PHASE = 24; // both sides with all their pieces
+    static const int KING_EXCHANGE_VALUE = 20000; // the king only ever takes last, nothing may be able to take it back
+
+    // written from white's side with a8 first, so a white piece on square s reads table[s ^ 56] and a black one table[s]
+    static const int middleGameTables[6][64];
+    static const int endGameTables[6][64];
+};
+
+#endif
@@ -28,17 +28,11 @@ void Functions::refreshFrame(sf::RenderWindow& window, Objects::Board& board, st
 
 	if (piece != nullptr)
 	{
-		if (!piece->legalMoves.empty())
+		for (auto& ind : board.shownMoves)
 		{
-			for (auto& direction : piece->legalMoves)
+			if (ind != nullptr)
 			{
-				for (auto& ind : direction)
-				{
-					if (ind != nullptr)
-					{
-						window.draw(ind->sprite);
-					}
-				}
+				window.draw(ind->sprite);
 			}
 		}
 		window.draw(piece->sprite);
@@ -68,6 +62,7 @@ void Functions::initGame(Objects::Board& board)
 {
 	Functions::sortPieceTextures();
 	Functions::placePieces(board);
+	board.startingPosition();
 }
 
 void Functions::placePieces(Objects::Board& board)
@@ -125,11 +120,11 @@ void Functions::sortPieceTextures()
 
 	Assets::pieceTextures.clear();
 
-	for (int colorIndex = 0; colorIndex < colorOrder.size(); colorIndex++)
+	for (size_t colorIndex = 0; colorIndex < colorOrder.size(); colorIndex++)
 	{
-		for (int pieceIndex = 0; pieceIndex < currentSide.size(); pieceIndex++)
+		for (size_t pieceIndex = 0; pieceIndex < currentSide.size(); pieceIndex++)
 		{
-			for (int unsortedPiece = 0; unsortedPiece < unsortedTextures.size(); unsortedPiece++)
+			for (size_t unsortedPiece = 0; unsortedPiece < unsortedTextures.size(); unsortedPiece++)
 			{
 				if ((colorOrder[colorIndex] + currentSide[pieceIndex]) == unsortedTextures[unsortedPiece]->name)
 				{
@@ -166,50 +161,53 @@ bool Functions::isPieceMatchTurn(std::shared_ptr<Objects::Piece> piece, short tu
 	return false;
 }
 
-void Functions::afterMove(std::shared_ptr<Objects::Piece> currentPiece, std::shared_ptr<Objects::Piece>& prevRoundPiece, short& turn, bool& check, Objects::Board& chessBoard, std::vector<std::shared_ptr<Objects::Indicator>>& checkLine, bool& alreadyCheckForBlock, bool& alreadyCheckForPromotion, std::vector<std::shared_ptr<Objects::Piece>>& pinnedPieces)
+void Functions::afterMove(short& turn, bool& check, Objects::Board& chessBoard, std::vector<std::shared_ptr<Objects::Indicator>>& checkLine)
 {
-	if (check && currentPiece->name != Objects::KING)
-	{
-		currentPiece->isPinned = true;
-		prevRoundPiece->pinnedPiece = currentPiece;
-		pinnedPieces.emplace_back(currentPiece);
-	}
-	else
-	{
-		currentPiece->getPinnedPieces(pinnedPieces, chessBoard);
-	}
-
-	checkLine.clear();
-	check = false;
-
-	if (currentPiece->name != Objects::KING) // get checkLine
-	{
-		currentPiece->getLegalMoves(chessBoard, true);
-		check = chessBoard.checkForCheck(currentPiece, chessBoard.getKingByColor(Objects::getOpposingColor(currentPiece->color)), checkLine);
-		currentPiece->deleteLegalMoves();
-	}
+	// the legal moves of the next side are generated once here, pins and checks are already part of them
 
 	chessBoard.deleteAllMoves();
-	chessBoard.resetPieceBools(turn);
-	prevRoundPiece = currentPiece;
-	alreadyCheckForBlock = false;
-	alreadyCheckForPromotion = false;
-	currentPiece->firstMove = false;
+	check = chessBoard.checkForCheck(checkLine);
+	chessBoard.updateLegalMoves();
 	turn *= -1;
 }
 
-void Functions::changePlace(Objects::Board& chessBoard, std::shared_ptr<Objects::Piece> currentPiece, std::shared_ptr<Objects::Piece> targetPiece, float currentPieceLastPosX, float currentPieceLastPosY)
+void Functions::changePlace(Objects::Board& chessBoard, Move move)
 {
-	chessBoard.snapPieceToTile(targetPiece, currentPieceLastPosX, currentPieceLastPosY);
-	chessBoard.setAllEnpassantFalse();
-	currentPiece->deleteLegalMoves();
+	// the tiles don't move, they are re-textured from the position
+	// every move is logged in san so a game can be copied out of the console and replayed
+
+	char san[Notation::MAX_SAN_LENGTH];
+	Notation::toSan(chessBoard.game.position, move, san);
+	std::cout << chessBoard.game.position.fullmoveNumber << (chessBoard.game.position.sideToMove == Position::WHITE ? ". " : "... ") << san << std::endl;
+	chessBoard.game.makeMove(move);
+	chessBoard.syncSprites();
+}
+
+Position::PieceType Functions::choosePromotion(sf::RenderWindow& window, Objects::Board& chessBoard, std::shared_ptr<Objects::Piece> piece, Functions::PromotionWindow& promotionWindow, std::vector<std::shared_ptr<Objects::Indicator>>* checkLine)
+{
+	// blocks until one of the options is clicked
+
+	Functions::refreshFrame(window, chessBoard, piece, true, &promotionWindow, checkLine);
+
+	while (true)
+	{
+		if (sf::Mouse::isButtonPressed(sf::Mouse::Left))
+		{
+			sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+			std::string name = promotionWindow.getPromotionButton(mousePos);
+			if (name != "invalid")
+			{
+				return (Position::PieceType)Objects::convertStringToPieceName(name);
+			}
+		}
+	}
 }
 
 std::shared_ptr<Objects::Piece> Functions::createNewPiece(Objects::Board& board, Objects::PieceName name, Objects::PieceColor color, std::shared_ptr<Assets::ObjectTexture> texture, uint8_t index)
 {
 	// creates a piece and adds it to onBoard vector
 
-	std::shared_ptr<Objects::Piece> newPiece = std::make_shared<Objects::Piece>(name, color, texture->texture);
+	std::shared_ptr<Objects::Piece> newPiece = std::make_shared<Objects::Piece>(name, color, texture->texture, Position::tileToSquare(index));
 
 	newPiece->sprite.setOrigin(newPiece->sprite.getLocalBounds().getSize().x / 2, newPiece->sprite.getLocalBounds().getSize().y / 2);
 	newPiece->sprite.setPosition(board.tilePoints[index][0], board.tilePoints[index][1]);
@@ -226,15 +224,6 @@ std::shared_ptr<Objects::Piece> Functions::getCurrentPiece(sf::RenderWindow& win
 	return chessBoard.getPieceByMouse(mousePos);
 }
 
-void Functions::blockingPieces(Objects::Board* chessBoard, bool check, bool& alreadyCheckForBlock, short turn, std::vector<std::shared_ptr<Objects::Indicator>>* checkLine)
-{
-	if (check)
-	{
-		chessBoard->getBlockingPieces(turn, checkLine);
-		alreadyCheckForBlock = true;
-	}
-}
-
 Functions::PromotionWindow::PromotionWindow(std::vector<std::string> options)
 {
 	this->shape.setRotation(90.f);
@@ -254,8 +243,7 @@ Functions::PromotionWindow::PromotionWindow(std::vector<std::string> options)
 
 void Functions::PromotionWindow::createOptions(std::vector<std::string> options)
 {
-	sf::Vector2f mainWindowSize = this->shape.getPosition();
-	for (short i = 0; i < options.size(); i++)
+	for (size_t i = 0; i < options.size(); i++)
 	{
 		sf::Vector2f pos(0.f, 0.f);
 		Functions::Button temp(pos, options[i]);
@@ -270,7 +258,7 @@ void Functions::PromotionWindow::reArrangeButtons()
 	float fixedY = mainWindowSize.top + mainWindowSize.height / 2;
 	float gapX = (mainWindowSize.width - 20.f) / this->options.size();
 	
-	for (short i = 0; i < options.size(); i++)
+	for (size_t i = 0; i < options.size(); i++)
 	{
 		sf::Vector2f pos(firstX + (i * gapX), fixedY);
 		options[i].shape.setPosition(pos);
@@ -309,21 +297,21 @@ Functions::OutcomeWindow::OutcomeWindow(const sf::Vector2f& center)
 	this->shape.setPosition(center);
 }
 
-void Functions::OutcomeWindow::changeTexture(Objects::GameOutcome outcome)
+void Functions::OutcomeWindow::changeTexture(Game::Outcome outcome)
 {
-	if (outcome == Objects::BLACK_WIN)
+	if (outcome == Game::BLACK_WIN)
 	{
 		std::cout << "blackWIn" << std::endl;
 		this->shape.setTexture(Assets::getObjectTexture("black_win")->texture);
 	}
-	else if (outcome == Objects::WHITE_WIN)
+	else if (outcome == Game::WHITE_WIN)
 	{
 		std::cout << "white win" << std::endl;
 		this->shape.setTexture(Assets::getObjectTexture("white_win")->texture);
 	}
-	else if (outcome == Objects::STALEMATE)
+	else if (outcome == Game::STALEMATE || outcome == Game::REPETITION || outcome == Game::FIFTY_MOVES || outcome == Game::INSUFFICIENT_MATERIAL) // every draw shares the stalemate picture
 	{
-		std::cout << "stalemate" << std::endl;
+		std::cout << "draw" << std::endl;
 		this->shape.setTexture(Assets::getObjectTexture("stalemate")->texture);
 	}
 	else
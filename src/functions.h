@@ -2,6 +2,9 @@
 #define FUNCTIONS_H
 
 #include "objects.h"
+#include "attacks.h"
+#include "notation.h"
+#include "search.h"
 
 class Functions
 {
@@ -38,7 +41,7 @@ public:
 
         OutcomeWindow(const sf::Vector2f& center);
 
-        void changeTexture(Objects::GameOutcome outcome);
+        void changeTexture(Game::Outcome outcome);
     };
 
     static void refreshFrame(sf::RenderWindow& window, Objects::Board& board, std::shared_ptr<Objects::Piece> piece = nullptr, bool promotionOpen = false, Functions::PromotionWindow* promotionWindow = nullptr, std::vector<std::shared_ptr<Objects::Indicator>>* checkLine = {}, Functions::OutcomeWindow* outcomeWindow = nullptr, bool gameEnd = false);
@@ -49,11 +52,11 @@ public:
     static void splitTextureName(std::string& initname, Objects::PieceColor& recolor, Objects::PieceName& rename);
     static bool isNameInRange(Objects::PieceName& name);
     static bool isPieceMatchTurn(std::shared_ptr<Objects::Piece> piece, short turn);
-    static void afterMove(std::shared_ptr<Objects::Piece> currentPiece, std::shared_ptr<Objects::Piece>& prevRoundPiece, short& turn, bool& check, Objects::Board& chessBoard, std::vector<std::shared_ptr<Objects::Indicator>>& checkLine, bool& alreadyCheckForBlock, bool& alreadyCheckForPromotion, std::vector<std::shared_ptr<Objects::Piece>>& pinnedPieces);
-    static void changePlace(Objects::Board& chessBoard, std::shared_ptr<Objects::Piece> currentPiece, std::shared_ptr<Objects::Piece> targetPiece, float currentPieceLastPosX, float currentPieceLastPosY);
+    static void afterMove(short& turn, bool& check, Objects::Board& chessBoard, std::vector<std::shared_ptr<Objects::Indicator>>& checkLine);
+    static void changePlace(Objects::Board& chessBoard, Move move);
+    static Position::PieceType choosePromotion(sf::RenderWindow& window, Objects::Board& chessBoard, std::shared_ptr<Objects::Piece> piece, Functions::PromotionWindow& promotionWindow, std::vector<std::shared_ptr<Objects::Indicator>>* checkLine);
     static std::shared_ptr<Objects::Piece> createNewPiece(Objects::Board& board, Objects::PieceName name, Objects::PieceColor color, std::shared_ptr<Assets::ObjectTexture> texture, uint8_t index);
     static std::shared_ptr<Objects::Piece> getCurrentPiece(sf::RenderWindow& window, Objects::Board& chessBoard);
-    static void blockingPieces(Objects::Board* chessBoard, bool check, bool& alreadyCheckForBlock, short turn, std::vector<std::shared_ptr<Objects::Indicator>>* checkLine);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "game.h"
+
+Game::Game()
+{
+    this->startingPosition();
+}
+
+void Game::startingPosition()
+{
+    this->position.setStartingPosition();
+    this->plyCount = 0;
+    this->undoCount = 0;
+    this->history.clear();
+}
+
+bool Game::loadFen(const char* fen)
+{
+    // moves played before the fen can't be taken back, the repetition history starts over with it too
+
+    if (!this->position.setFromFen(fen))
+    {
+        return false;
+    }
+    this->plyCount = 0;
+    this->undoCount = 0;
+    this->history.clear();
+    return true;
+}
+
+int Game::getFen(char* buffer) const
+{
+    return this->position.toFen(buffer);
+}
+
+void Game::makeMove(Move move)
+{
+    // once the ring is full the oldest ply is overwritten, only that one can't be taken back anymore
+
+    int index = this->plyCount % Game::MAX_PLIES;
+    this->playedMoves[index] = move;
+    this->history.push(this->position.hash);
+    this->position.makeMove(move, this->undoStack[index]);
+    this->plyCount++;
+    if (this->undoCount < Game::MAX_PLIES)
+    {
+        this->undoCount++;
+    }
+}
+
+bool Game::unmakeMove()
+{
+    if (this->undoCount == 0)
+    {
+        return false;
+    }
+    this->plyCount--;
+    this->undoCount--;
+    int index = this->plyCount % Game::MAX_PLIES;
+    this->position.unmakeMove(this->playedMoves[index], this->undoStack[index]);
+    this->history.pop();
+    return true;
+}
+
+Game::Outcome Game::getOutcome() const
+{
+    if (this->position.isInsufficientMaterial())
+    {
+        return Game::INSUFFICIENT_MATERIAL;
+    }
+
+    if (MoveGen::hasLegalMove(this->position))
+    {
+        // a mate on the last allowed ply still counts, so the draws are only looked at when there are moves left
+        if (this->position.halfmoveClock >= 100)
+        {
+            return Game::FIFTY_MOVES;
+        }
+        if (this->history.countOccurrences(this->position.hash, this->position.halfmoveClock) >= 3)
+        {
+            return Game::REPETITION;
+        }
+        return Game::NO_OUTCOME;
+    }
+
+    if (!MoveGen::getCheckers(this->position))
+    {
+        return Game::STALEMATE;
+    }
+    return this->position.sideToMove == Position::WHITE ? Game::BLACK_WIN : Game::WHITE_WIN;
+}
@@ -0,0 +1,45 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "movegen.h"
+#include "repetition.h"
+
+// a game in progress: the position plus what the rules need to know about how it got there
+// nothing here draws anything, the board in objects.h only shows a Game
+
+class Game
+{
+public:
+    enum Outcome
+    {
+        WHITE_WIN = 0,
+        BLACK_WIN = 1,
+        STALEMATE = 2,
+        NO_OUTCOME = 3,
+        REPETITION = 4, // the same position for the third time
+        FIFTY_MOVES = 5, // a hundred plies without a capture or pawn move
+        INSUFFICIENT_MATERIAL = 6 // nobody can mate anymore
+    };
+
+    static const int MAX_PLIES = 1024;
+
+    Position position;
+    // undo stack used as a ring, fixed size so making a move never allocates
+    // a ply is stored at plyCount % MAX_PLIES, past MAX_PLIES plies the oldest one is overwritten by the newest
+    Move playedMoves[Game::MAX_PLIES];
+    Position::Undo undoStack[Game::MAX_PLIES];
+    int plyCount; // plies played since the start or the last fen
+    int undoCount; // how many of them can still be taken back, at most MAX_PLIES
+    RepetitionHistory history;
+
+    Game();
+
+    void startingPosition();
+    bool loadFen(const char* fen); // false and nothing changes if the fen is malformed
+    int getFen(char* buffer) const; // buffer must hold Position::MAX_FEN_LENGTH chars
+    void makeMove(Move move); // the move has to be legal
+    bool unmakeMove(); // false if there is nothing left to take back
+    Game::Outcome getOutcome() const;
+};
+
+#endif
@@ -17,21 +17,18 @@ int main()
 {
     std::shared_ptr<Objects::Piece> currentPiece = nullptr;
     std::shared_ptr<Objects::Piece> targetPiece = nullptr;
-    std::shared_ptr<Objects::Piece> prevPiece = nullptr;
-    std::shared_ptr<Objects::Piece> prevRoundPiece = nullptr;
-    std::shared_ptr<Objects::Piece> toBePromoted = nullptr;
 
-    std::vector<std::shared_ptr<Objects::Piece>> pinnedPieces{};
 	std::vector<std::shared_ptr<Objects::Indicator>> checkLine{};
 
     float currentPieceLastPosX{}, currentPieceLastPosY{};
     short turn = 1; //1 -> white, -1 -> black
     bool check = false;
     bool gameEnd = false;
-	bool alreadyCheckForBlock = false;
-    bool alreadyCheckForPromotion = false;
-    bool promotionWindowOpen = false;
+    bool engineThinking = false; // the engine plays the side to move, the board takes no input until it has
 
+    Search engine;
+
+    Attacks::init();
     Assets::loadDirectoryElements(pathToOtherTextures);
     Assets::loadDirectoryElements(pathToPieceTextures);
 
@@ -58,13 +55,8 @@ int main()
         sf::Event event;
         while (window.pollEvent(event))
         {
-            if (event.type == sf::Event::MouseButtonPressed)
+            if (event.type == sf::Event::MouseButtonPressed && !engineThinking)
             {
-                if (!alreadyCheckForBlock)
-                {
-                    Functions::blockingPieces(&chessBoard, check, alreadyCheckForBlock, turn, &checkLine);
-                }
-
                 currentPiece = Functions::getCurrentPiece(window, chessBoard);
                 if (currentPiece == nullptr)
                 {
@@ -76,16 +68,8 @@ int main()
 
                 if (currentPiece->name != Objects::CELL && Functions::isNameInRange(currentPiece->name) && Functions::isPieceMatchTurn(currentPiece, turn))
                 {
-                    if ((check && !chessBoard.canPieceBlock(currentPiece) && currentPiece->name != Objects::KING) || currentPiece->isPinned)
-                    {
-                        continue;
-                    }
-                    else if (currentPiece != prevPiece && currentPiece->legalMoves.size() == 0 && !currentPiece->isPinned)
-                    {
-                        currentPiece->getLegalMoves(chessBoard);
-                    }
-
-                    prevPiece = currentPiece;
+                    currentPiece->getLegalMoves(chessBoard);
+                    chessBoard.showLegalMoves(currentPiece);
 
                     while (sf::Mouse::isButtonPressed(sf::Mouse::Left))
                     {
@@ -118,38 +102,19 @@ int main()
                 {
                     chessBoard.snapPieceToTile(currentPiece, currentPieceLastPosX, currentPieceLastPosY);
                 }
-                else if (targetPiece->name == Objects::CELL && currentPiece->isTargetInMoves(targetPiece)) // regular move
+                else if (currentPiece->isTargetInMoves(targetPiece)) // captures, en passant and castling are handled by the position
                 {
-                    if (currentPiece->isMoveEnpassant())
-                    {
-                        chessBoard.removeEnpassantPiece(currentPiece->sprite.getPosition(), turn);
-                    }
-                    Functions::changePlace(chessBoard, currentPiece, targetPiece, currentPieceLastPosX, currentPieceLastPosY);
-                    if (currentPiece->name == Objects::PAWN)
+                    Move move = currentPiece->getMoveTo(targetPiece);
+                    if (move.getFlag() == Move::PROMOTION)
                     {
-                        chessBoard.checkEnpassant(currentPiece);
+                        move = Move(move.getFrom(), move.getTo(), Move::PROMOTION, Functions::choosePromotion(window, chessBoard, currentPiece, promotionWindow, &checkLine));
                     }
-                    Functions::afterMove(currentPiece, prevRoundPiece, turn, check, chessBoard, checkLine, alreadyCheckForBlock, alreadyCheckForPromotion, pinnedPieces);
 
-                    Objects::GameOutcome outcome = chessBoard.checkForOutcome(currentPiece->color, check, true);
-                    if (outcome != Objects::NO_OUTCOME)
-                    {
-                        outcomeWindow.changeTexture(outcome);
-                        gameEnd = true;
-                    }
-                }
-                else if (targetPiece->color != currentPiece->color && currentPiece->isTargetInMoves(targetPiece)) // attack move
-                {
-                    chessBoard.removePiece(targetPiece);
-                    Functions::changePlace(chessBoard, currentPiece, targetPiece, currentPieceLastPosX, currentPieceLastPosY);
-                    if (currentPiece->name == Objects::PAWN)
-                    {
-                        chessBoard.checkEnpassant(currentPiece);
-                    }
-                    Functions::afterMove(currentPiece, prevRoundPiece, turn, check, chessBoard, checkLine, alreadyCheckForBlock, alreadyCheckForPromotion, pinnedPieces);
+                    Functions::changePlace(chessBoard, move);
+                    Functions::afterMove(turn, check, chessBoard, checkLine);
 
-                    Objects::GameOutcome outcome = chessBoard.checkForOutcome(currentPiece->color, check, true);
-                    if (outcome != Objects::NO_OUTCOME)
+                    Game::Outcome outcome = chessBoard.checkForOutcome();
+                    if (outcome != Game::NO_OUTCOME)
                     {
                         outcomeWindow.changeTexture(outcome);
                         gameEnd = true;
@@ -161,49 +126,83 @@ int main()
                 }
             }
 
-            if (!alreadyCheckForPromotion) // check promotion
+            if (event.type == sf::Event::Closed)
             {
-                toBePromoted = chessBoard.getPromotingPiece();
-                alreadyCheckForPromotion = true;
-                if (toBePromoted != nullptr)
+                window.close();
+            }
+
+            if (event.type == sf::Event::KeyPressed)
+            {
+                if (engineThinking && event.key.code != sf::Keyboard::Space) // anything that changes the board drops the search
                 {
-                    promotionWindowOpen = true;
-                    Functions::refreshFrame(window, chessBoard, currentPiece, promotionWindowOpen, &promotionWindow, &checkLine);
+                    engine.stop();
+                    engine.wait();
+                    engineThinking = false;
+                }
 
-                    while (promotionWindowOpen)
-                    {
-                        if (sf::Mouse::isButtonPressed(sf::Mouse::Left))
+                if (event.key.code == sf::Keyboard::Space && !engineThinking && chessBoard.game.getOutcome() == Game::NO_OUTCOME) // let the engine move
+                {
+                    Search::Limits limits;
+                    limits.moveTime = engineMoveTime;
+                    engine.start(chessBoard.game, limits, [](const Search::Report& report)
                         {
-                            sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-                            std::string name = promotionWindow.getPromotionButton(mousePos);
-                            if (name != "invalid")
-                            {
-                                toBePromoted->transformPiece(name);
-                                toBePromoted->getLegalMoves(chessBoard, false);
-                                check = chessBoard.checkForCheck(toBePromoted, chessBoard.getKingByColor(Objects::getOpposingColor(currentPiece->color)), checkLine);
-                                promotionWindowOpen = false;
-                            }
-                        }
+                            std::cout << "depth " << report.depth << " score " << report.score << " nodes " << report.nodes << " nps " << report.nodesPerSecond << "\n";
+                        });
+                    engineThinking = true;
+                }
+                else if (sf::Keyboard::isKeyPressed(sf::Keyboard::R))
+                {
+                    chessBoard.startingPosition();
+                    checkLine.clear();
+                    check = false;
+                    turn = 1;
+                }
+                else if (sf::Keyboard::isKeyPressed(sf::Keyboard::BackSpace) && chessBoard.game.unmakeMove()) // take back
+                {
+                    chessBoard.syncSprites();
+                    Functions::afterMove(turn, check, chessBoard, checkLine);
+                }
+                else if (event.key.control && event.key.code == sf::Keyboard::V) // load a fen from the clipboard
+                {
+                    if (chessBoard.loadFen(sf::Clipboard::getString().toAnsiString().c_str()))
+                    {
+                        turn = chessBoard.game.position.sideToMove == Position::WHITE ? -1 : 1;
+                        Functions::afterMove(turn, check, chessBoard, checkLine);
                     }
+                    else
+                    {
+                        std::cout << "invalid fen\n";
+                    }
+                }
+                else if (event.key.control && event.key.code == sf::Keyboard::C) // copy the current fen
+                {
+                    char fen[Position::MAX_FEN_LENGTH];
+                    chessBoard.game.getFen(fen);
+                    sf::Clipboard::setString(fen);
+                    std::cout << fen << "\n";
                 }
             }
+        }
 
-            if (event.type == sf::Event::Closed)
+        if (engineThinking && !engine.isSearching()) // the engine's move is played like a dragged one
+        {
+            Move move = engine.wait();
+            engineThinking = false;
+            if (move != Move::none())
             {
-                window.close();
-            }
+                Functions::changePlace(chessBoard, move);
+                Functions::afterMove(turn, check, chessBoard, checkLine);
 
-            if (event.type == sf::Event::KeyPressed)
-            {
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::R))
+                Game::Outcome outcome = chessBoard.checkForOutcome();
+                if (outcome != Game::NO_OUTCOME)
                 {
-                    chessBoard.startingPosition();
-                    turn = 1;
+                    outcomeWindow.changeTexture(outcome);
+                    gameEnd = true;
                 }
             }
         }
 
-        Functions::refreshFrame(window, chessBoard, currentPiece, promotionWindowOpen, &promotionWindow, &checkLine, &outcomeWindow, gameEnd);
+        Functions::refreshFrame(window, chessBoard, currentPiece, false, &promotionWindow, &checkLine, &outcomeWindow, gameEnd);
 
         if (gameEnd)
         {
@@ -0,0 +1,97 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include "position.h"
+
+// a move packed into 16 bits:
+// bits 0-5 from square, bits 6-11 to square, bits 12-13 promotion piece, bits 14-15 flag
+
+class Move
+{
+public:
+    enum Flag
+    {
+        NORMAL = 0,
+        PROMOTION = 1 << 14,
+        EN_PASSANT = 2 << 14,
+        CASTLING = 3 << 14 // stored as king from -> king to
+    };
+
+    uint16_t data;
+
+    Move() = default;
+    constexpr Move(uint8_t from, uint8_t to, Move::Flag flag = Move::NORMAL, Position::PieceType promotion = Position::KNIGHT)
+        : data((uint16_t)(from | (to << 6) | (Move::getPromotionIndex(promotion) << 12) | flag))
+    {
+    }
+
+    static constexpr Move none() { return Move(0, 0); }
+
+    uint8_t getFrom() const { return this->data & 0x3F; }
+    uint8_t getTo() const { return (this->data >> 6) & 0x3F; }
+    Move::Flag getFlag() const { return (Move::Flag)(this->data & (3 << 14)); }
+    Position::PieceType getPromotion() const
+    {
+        const Position::PieceType promotions[4] = { Position::KNIGHT, Position::BISHOP, Position::ROOK, Position::QUEEN };
+        return promotions[(this->data >> 12) & 3];
+    }
+
+    bool operator==(const Move& other) const { return this->data == other.data; }
+    bool operator!=(const Move& other) const { return this->data != other.data; }
+
+private:
+    static constexpr int getPromotionIndex(Position::PieceType type)
+    {
+        return type == Position::BISHOP ? 1 : (type == Position::ROOK ? 2 : (type == Position::QUEEN ? 3 : 0));
+    }
+};
+
+// fixed capacity list that lives on the stack, no legal position has more than 218 moves
+
+class MoveList
+{
+public:
+    static const int CAPACITY = 256;
+
+    Move moves[MoveList::CAPACITY];
+    int count = 0;
+
+    void add(Move move) { this->moves[this->count++] = move; }
+    void clear() { this->count = 0; }
+    int size() const { return this->count; }
+    bool empty() const { return this->count == 0; }
+
+    bool contains(Move move) const
+    {
+        for (int i = 0; i < this->count; i++)
+        {
+            if (this->moves[i] == move)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // drops every move the predicate rejects, the order of the rest is kept
+    template <typename Predicate>
+    void keepIf(Predicate predicate)
+    {
+        int kept = 0;
+        for (int i = 0; i < this->count; i++)
+        {
+            if (predicate(this->moves[i]))
+            {
+                this->moves[kept++] = this->moves[i];
+            }
+        }
+        this->count = kept;
+    }
+
+    Move* begin() { return this->moves; }
+    Move* end() { return this->moves + this->count; }
+    const Move* begin() const { return this->moves; }
+    const Move* end() const { return this->moves + this->count; }
+};
+
+#endif
@@ -0,0 +1,372 @@
+#include "movegen.h"
+
+void MoveGen::generateLegalMoves(const Position& position, MoveList& moves)
+{
+    // checkers, the check mask and the pin rays are worked out once, then only legal moves are emitted
+
+    Position::Color us = (Position::Color)position.sideToMove;
+    Position::Color them = Position::getOpposingColor(us);
+    uint64_t ours = position.getOccupancy(us);
+    uint64_t occupied = position.getOccupancy();
+    uint8_t kingSquare = position.getKingSquare(us);
+
+    // the king is lifted off the board so the enemy sliders x-ray through it, it can't hide behind itself on their line
+    uint64_t danger = MoveGen::getAttackedSquares(position, them, occupied ^ Position::squareMask(kingSquare));
+    MoveGen::addMoves(kingSquare, Attacks::getKingAttacks(kingSquare) & ~ours & ~danger, moves);
+
+    MoveGen::Restrictions restrictions;
+    if (!MoveGen::getRestrictions(position, us, kingSquare, restrictions))
+    {
+        return; // double check, only the king can move
+    }
+    if (!restrictions.checkers)
+    {
+        MoveGen::addCastlingMoves(position, us, occupied, danger, moves);
+    }
+
+    for (uint8_t type = Position::ROOK; type < Position::NO_PIECE_TYPE; type++)
+    {
+        if (type == Position::KING)
+        {
+            continue;
+        }
+
+        uint64_t pieces = position.pieces[us][type];
+        while (pieces)
+        {
+            uint8_t from = Position::popLsb(pieces);
+            uint64_t allowed = restrictions.getAllowed(from);
+
+            if (type == Position::PAWN)
+            {
+                uint64_t targets = MoveGen::getPawnTargets(position, us, from) & allowed;
+                while (targets)
+                {
+                    MoveGen::addPawnMove(from, Position::popLsb(targets), moves);
+                }
+                if (MoveGen::isEnpassantLegal(position, us, from))
+                {
+                    moves.add(Move(from, position.enpassantSquare, Move::EN_PASSANT));
+                }
+            }
+            else
+            {
+                MoveGen::addMoves(from, MoveGen::getAttacks((Position::PieceType)type, us, from, occupied) & ~ours & allowed, moves);
+            }
+        }
+    }
+}
+
+void MoveGen::generateCaptures(const Position& position, MoveList& moves)
+{
+    // the same restrictions as generateLegalMoves, but every piece is limited to enemy cells from the start
+    // and pawns add pushes onto the last rank, no quiet move is ever looked at
+    // the king's few captures are tested one by one, cheaper than every cell the enemy attacks
+
+    Position::Color us = (Position::Color)position.sideToMove;
+    Position::Color them = Position::getOpposingColor(us);
+    uint64_t theirs = position.getOccupancy(them);
+    uint64_t occupied = position.getOccupancy();
+    uint8_t kingSquare = position.getKingSquare(us);
+
+    uint64_t kingTargets = Attacks::getKingAttacks(kingSquare) & theirs;
+    uint64_t withoutKing = occupied ^ Position::squareMask(kingSquare);
+    while (kingTargets)
+    {
+        uint8_t to = Position::popLsb(kingTargets);
+        if (!MoveGen::isSquareAttacked(position, to, them, withoutKing))
+        {
+            moves.add(Move(kingSquare, to));
+        }
+    }
+
+    MoveGen::Restrictions restrictions;
+    if (!MoveGen::getRestrictions(position, us, kingSquare, restrictions))
+    {
+        return;
+    }
+
+    int forward = us == Position::WHITE ? 8 : -8;
+    uint8_t promotionRank = us == Position::WHITE ? 6 : 1; // the rank a pawn promotes from
+    for (uint8_t type = Position::ROOK; type < Position::NO_PIECE_TYPE; type++)
+    {
+        if (type == Position::KING)
+        {
+            continue;
+        }
+
+        uint64_t pieces = position.pieces[us][type];
+        while (pieces)
+        {
+            uint8_t from = Position::popLsb(pieces);
+            uint64_t allowed = restrictions.getAllowed(from);
+
+            if (type == Position::PAWN)
+            {
+                uint64_t targets = Attacks::getPawnAttacks(us, from) & theirs;
+                if (Position::getRank(from) == promotionRank && !(occupied & Position::squareMask((uint8_t)(from + forward))))
+                {
+                    targets |= Position::squareMask((uint8_t)(from + forward));
+                }
+                targets &= allowed;
+                while (targets)
+                {
+                    MoveGen::addPawnMove(from, Position::popLsb(targets), moves);
+                }
+                if (MoveGen::isEnpassantLegal(position, us, from))
+                {
+                    moves.add(Move(from, position.enpassantSquare, Move::EN_PASSANT));
+                }
+            }
+            else
+            {
+                MoveGen::addMoves(from, MoveGen::getAttacks((Position::PieceType)type, us, from, occupied) & theirs & allowed, moves);
+            }
+        }
+    }
+}
+
+bool MoveGen::hasLegalMove(const Position& position)
+{
+    // same rules as generateLegalMoves but nothing is stored, it stops at the first legal move it sees
+    // the king goes first since it usually has a free cell, castling is never needed: if it's legal the step next to the king is too
+
+    Position::Color us = (Position::Color)position.sideToMove;
+    Position::Color them = Position::getOpposingColor(us);
+    uint64_t ours = position.getOccupancy(us);
+    uint64_t occupied = position.getOccupancy();
+    uint8_t kingSquare = position.getKingSquare(us);
+
+    uint64_t kingTargets = Attacks::getKingAttacks(kingSquare) & ~ours;
+    uint64_t withoutKing = occupied ^ Position::squareMask(kingSquare);
+    while (kingTargets)
+    {
+        if (!MoveGen::isSquareAttacked(position, Position::popLsb(kingTargets), them, withoutKing))
+        {
+            return true;
+        }
+    }
+
+    MoveGen::Restrictions restrictions;
+    if (!MoveGen::getRestrictions(position, us, kingSquare, restrictions))
+    {
+        return false;
+    }
+
+    for (uint8_t type = Position::ROOK; type < Position::NO_PIECE_TYPE; type++)
+    {
+        if (type == Position::KING)
+        {
+            continue;
+        }
+
+        uint64_t pieces = position.pieces[us][type];
+        while (pieces)
+        {
+            uint8_t from = Position::popLsb(pieces);
+            uint64_t allowed = restrictions.getAllowed(from);
+
+            if (type == Position::PAWN)
+            {
+                if ((MoveGen::getPawnTargets(position, us, from) & allowed) || MoveGen::isEnpassantLegal(position, us, from))
+                {
+                    return true;
+                }
+            }
+            else if (MoveGen::getAttacks((Position::PieceType)type, us, from, occupied) & ~ours & allowed)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool MoveGen::getRestrictions(const Position& position, Position::Color us, uint8_t kingSquare, MoveGen::Restrictions& restrictions)
+{
+    // false in double check, then nothing but the king may move and the rest is left unfilled
+
+    Position::Color them = Position::getOpposingColor(us);
+    uint64_t ours = position.getOccupancy(us);
+    uint64_t theirs = position.getOccupancy(them);
+    uint64_t occupied = ours | theirs;
+
+    restrictions.checkers = MoveGen::getAttackersTo(position, kingSquare, occupied) & theirs;
+    if (Position::popCount(restrictions.checkers) > 1)
+    {
+        return false;
+    }
+
+    // squares a non king move has to land on: anywhere, or on the checker and the cells between it and the king
+    restrictions.checkMask = ~0ULL;
+    if (restrictions.checkers)
+    {
+        restrictions.checkMask = restrictions.checkers | Attacks::getBetween(kingSquare, Position::lsb(restrictions.checkers));
+    }
+
+    // an enemy slider that sees the king through exactly one of our pieces pins it to that line
+    restrictions.pinned = 0;
+    uint64_t snipers = (Attacks::getRookAttacks(kingSquare, theirs) & (position.pieces[them][Position::ROOK] | position.pieces[them][Position::QUEEN]))
+        | (Attacks::getBishopAttacks(kingSquare, theirs) & (position.pieces[them][Position::BISHOP] | position.pieces[them][Position::QUEEN]));
+    while (snipers)
+    {
+        uint8_t sniper = Position::popLsb(snipers);
+        uint64_t ray = Attacks::getBetween(kingSquare, sniper);
+        uint64_t blockers = ray & occupied;
+        if (Position::popCount(blockers) == 1 && (blockers & ours))
+        {
+            restrictions.pinned |= blockers;
+            restrictions.pinRays[Position::lsb(blockers)] = ray | Position::squareMask(sniper);
+        }
+    }
+    return true;
+}
+
+uint64_t MoveGen::getAttacks(Position::PieceType type, Position::Color color, uint8_t square, uint64_t occupied)
+{
+    switch (type)
+    {
+        case Position::PAWN: return Attacks::getPawnAttacks(color, square);
+        case Position::KNIGHT: return Attacks::getKnightAttacks(square);
+        case Position::BISHOP: return Attacks::getBishopAttacks(square, occupied);
+        case Position::ROOK: return Attacks::getRookAttacks(square, occupied);
+        case Position::QUEEN: return Attacks::getQueenAttacks(square, occupied);
+        case Position::KING: return Attacks::getKingAttacks(square);
+        default: return 0;
+    }
+}
+
+uint64_t MoveGen::getAttackersTo(const Position& position, uint8_t square, uint64_t occupied)
+{
+    const uint64_t (&white)[6] = position.pieces[Position::WHITE];
+    const uint64_t (&black)[6] = position.pieces[Position::BLACK];
+
+    return (Attacks::getPawnAttacks(Position::WHITE, square) & black[Position::PAWN])
+        | (Attacks::getPawnAttacks(Position::BLACK, square) & white[Position::PAWN])
+        | (Attacks::getKnightAttacks(square) & (white[Position::KNIGHT] | black[Position::KNIGHT]))
+        | (Attacks::getKingAttacks(square) & (white[Position::KING] | black[Position::KING]))
+        | (Attacks::getBishopAttacks(square, occupied) & (white[Position::BISHOP] | black[Position::BISHOP] | white[Position::QUEEN] | black[Position::QUEEN]))
+        | (Attacks::getRookAttacks(square, occupied) & (white[Position::ROOK] | black[Position::ROOK] | white[Position::QUEEN] | black[Position::QUEEN]));
+}
+
+uint64_t MoveGen::getAttackedSquares(const Position& position, Position::Color by, uint64_t occupied)
+{
+    // every cell the side attacks, pawns all at once and the rest one piece at a time from the tables
+
+    const uint64_t (&enemy)[6] = position.pieces[by];
+    uint64_t attacked = Attacks::getPawnAttacks(by, enemy[Position::PAWN]) | Attacks::getKingAttacks(Position::lsb(enemy[Position::KING]));
+
+    for (uint64_t knights = enemy[Position::KNIGHT]; knights; )
+    {
+        attacked |= Attacks::getKnightAttacks(Position::popLsb(knights));
+    }
+    for (uint64_t diagonal = enemy[Position::BISHOP] | enemy[Position::QUEEN]; diagonal; )
+    {
+        attacked |= Attacks::getBishopAttacks(Position::popLsb(diagonal), occupied);
+    }
+    for (uint64_t straight = enemy[Position::ROOK] | enemy[Position::QUEEN]; straight; )
+    {
+        attacked |= Attacks::getRookAttacks(Position::popLsb(straight), occupied);
+    }
+    return attacked;
+}
+
+bool MoveGen::isSquareAttacked(const Position& position, uint8_t square, Position::Color by, uint64_t occupied)
+{
+    const uint64_t (&enemy)[6] = position.pieces[by];
+
+    return (Attacks::getPawnAttacks(Position::getOpposingColor(by), square) & enemy[Position::PAWN])
+        || (Attacks::getKnightAttacks(square) & enemy[Position::KNIGHT])
+        || (Attacks::getKingAttacks(square) & enemy[Position::KING])
+        || (Attacks::getBishopAttacks(square, occupied) & (enemy[Position::BISHOP] | enemy[Position::QUEEN]))
+        || (Attacks::getRookAttacks(square, occupied) & (enemy[Position::ROOK] | enemy[Position::QUEEN]));
+}
+
+uint64_t MoveGen::getCheckers(const Position& position)
+{
+    Position::Color us = (Position::Color)position.sideToMove;
+    uint64_t attackers = MoveGen::getAttackersTo(position, position.getKingSquare(us), position.getOccupancy());
+    return attackers & position.getOccupancy(Position::getOpposingColor(us));
+}
+
+uint64_t MoveGen::getPawnTargets(const Position& position, Position::Color us, uint8_t from)
+{
+    int forward = us == Position::WHITE ? 8 : -8;
+    uint8_t startingRank = us == Position::WHITE ? 1 : 6;
+    uint64_t occupied = position.getOccupancy();
+    uint64_t targets = Attacks::getPawnAttacks(us, from) & position.getOccupancy(Position::getOpposingColor(us));
+
+    uint8_t to = (uint8_t)(from + forward);
+    if (!(occupied & Position::squareMask(to)))
+    {
+        targets |= Position::squareMask(to);
+
+        uint8_t doubleTo = (uint8_t)(to + forward);
+        if (Position::getRank(from) == startingRank && !(occupied & Position::squareMask(doubleTo)))
+        {
+            targets |= Position::squareMask(doubleTo);
+        }
+    }
+    return targets;
+}
+
+bool MoveGen::isEnpassantLegal(const Position& position, Position::Color us, uint8_t from)
+{
+    if (position.enpassantSquare == Position::NO_SQUARE || !(Attacks::getPawnAttacks(us, from) & Position::squareMask(position.enpassantSquare)))
+    {
+        return false;
+    }
+
+    // two pawns leave the same rank at once, so the masks can't tell if this exposes the king, the move is simply tried
+    uint64_t capturedPawn = Position::squareMask(position.enpassantSquare ^ 8);
+    uint64_t after = (position.getOccupancy() ^ Position::squareMask(from) ^ capturedPawn) | Position::squareMask(position.enpassantSquare);
+    uint64_t attackers = MoveGen::getAttackersTo(position, position.getKingSquare(us), after) & position.getOccupancy(Position::getOpposingColor(us));
+    return (attackers & ~capturedPawn) == 0;
+}
+
+void MoveGen::addPawnMove(uint8_t from, uint8_t to, MoveList& moves)
+{
+    if (Position::getRank(to) == 0 || Position::getRank(to) == 7)
+    {
+        moves.add(Move(from, to, Move::PROMOTION, Position::QUEEN));
+        moves.add(Move(from, to, Move::PROMOTION, Position::ROOK));
+        moves.add(Move(from, to, Move::PROMOTION, Position::BISHOP));
+        moves.add(Move(from, to, Move::PROMOTION, Position::KNIGHT));
+    }
+    else
+    {
+        moves.add(Move(from, to));
+    }
+}
+
+void MoveGen::addCastlingMoves(const Position& position, Position::Color us, uint64_t occupied, uint64_t danger, MoveList& moves)
+{
+    // the caller made sure the king is not in check, the cells it passes and lands on can't be in danger either
+
+    uint8_t kingSquare = us == Position::WHITE ? 4 : 60;
+    uint8_t kingside = us == Position::WHITE ? Position::WHITE_KINGSIDE : Position::BLACK_KINGSIDE;
+    uint8_t queenside = us == Position::WHITE ? Position::WHITE_QUEENSIDE : Position::BLACK_QUEENSIDE;
+    uint64_t rooks = position.pieces[us][Position::ROOK];
+
+    if ((position.castlingRights & kingside) && (rooks & Position::squareMask(kingSquare + 3))
+        && !(occupied & Attacks::getBetween(kingSquare, kingSquare + 3))
+        && !(danger & Attacks::getBetween(kingSquare, kingSquare + 3)))
+    {
+        moves.add(Move(kingSquare, kingSquare + 2, Move::CASTLING));
+    }
+
+    if ((position.castlingRights & queenside) && (rooks & Position::squareMask(kingSquare - 4))
+        && !(occupied & Attacks::getBetween(kingSquare, kingSquare - 4))
+        && !(danger & Attacks::getBetween(kingSquare, kingSquare - 3))) // b1/b8 may be attacked, the king doesn't cross it
+    {
+        moves.add(Move(kingSquare, kingSquare - 2, Move::CASTLING));
+    }
+}
+
+void MoveGen::addMoves(uint8_t from, uint64_t targets, MoveList& moves)
+{
+    while (targets)
+    {
+        moves.add(Move(from, Position::popLsb(targets)));
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "attacks.h"
+#include "move.h"
+
+// move generation straight from the bitboards, everything is written into a caller owned MoveList
+
+class MoveGen
+{
+public:
+    static void generateLegalMoves(const Position& position, MoveList& moves);
+    static void generateCaptures(const Position& position, MoveList& moves); // legal captures and promotions only, for the quiescence search
+    static bool hasLegalMove(const Position& position); // no list is built, enough for telling mate and stalemate apart from a game going on
+    static uint64_t getAttacks(Position::PieceType type, Position::Color color, uint8_t square, uint64_t occupied);
+    static uint64_t getAttackersTo(const Position& position, uint8_t square, uint64_t occupied); // pieces of both colors
+    static uint64_t getAttackedSquares(const Position& position, Position::Color by, uint64_t occupied);
+    static bool isSquareAttacked(const Position& position, uint8_t square, Position::Color by, uint64_t occupied);
+    static uint64_t getCheckers(const Position& position); // enemy pieces giving check to the side to move
+
+private:
+    struct Restrictions // what every non king move of the side to move has to respect
+    {
+        uint64_t checkers;
+        uint64_t checkMask;
+        uint64_t pinned;
+        uint64_t pinRays[64]; // only filled in for the pinned squares
+
+        uint64_t getAllowed(uint8_t from) const { return (this->pinned & Position::squareMask(from)) ? this->checkMask & this->pinRays[from] : this->checkMask; }
+    };
+
+    static bool getRestrictions(const Position& position, Position::Color us, uint8_t kingSquare, MoveGen::Restrictions& restrictions);
+    static uint64_t getPawnTargets(const Position& position, Position::Color us, uint8_t from); // pushes and captures, en passant is checked on its own
+    static bool isEnpassantLegal(const Position& position, Position::Color us, uint8_t from);
+    static void addPawnMove(uint8_t from, uint8_t to, MoveList& moves);
+    static void addCastlingMoves(const Position& position, Position::Color us, uint64_t occupied, uint64_t danger, MoveList& moves);
+    static void addMoves(uint8_t from, uint64_t targets, MoveList& moves);
+};
+
+#endif
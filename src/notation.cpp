@@ -0,0 +1,234 @@
+#include "notation.h"
+
+int Notation::toSan(const Position& position, Move move, char* buffer)
+{
+    uint8_t from = move.getFrom();
+    uint8_t to = move.getTo();
+    Position::PieceType type = position.getPieceTypeOn(from);
+    char* out = buffer;
+
+    if (move.getFlag() == Move::CASTLING)
+    {
+        const char* castle = to > from ? "O-O" : "O-O-O";
+        while (*castle)
+        {
+            *out++ = *castle++;
+        }
+    }
+    else
+    {
+        bool capture = move.getFlag() == Move::EN_PASSANT || position.getColorOn(to) != Position::NO_COLOR;
+
+        if (type == Position::PAWN)
+        {
+            if (capture)
+            {
+                *out++ = (char)('a' + Position::getFile(from));
+            }
+        }
+        else
+        {
+            *out++ = Notation::pieceToChar(type);
+
+            // the file if that's enough to tell the pieces apart, then the rank, the whole square as a last resort
+            MoveList moves;
+            MoveGen::generateLegalMoves(position, moves);
+            bool ambiguous = false;
+            bool sameFile = false;
+            bool sameRank = false;
+            for (const Move& other : moves)
+            {
+                uint8_t otherFrom = other.getFrom();
+                if (other.getTo() != to || otherFrom == from || position.getPieceTypeOn(otherFrom) != type)
+                {
+                    continue;
+                }
+                ambiguous = true;
+                sameFile = sameFile || Position::getFile(otherFrom) == Position::getFile(from);
+                sameRank = sameRank || Position::getRank(otherFrom) == Position::getRank(from);
+            }
+            if (ambiguous && (!sameFile || sameRank))
+            {
+                *out++ = (char)('a' + Position::getFile(from));
+            }
+            if (ambiguous && sameFile)
+            {
+                *out++ = (char)('1' + Position::getRank(from));
+            }
+        }
+
+        if (capture)
+        {
+            *out++ = 'x';
+        }
+        *out++ = (char)('a' + Position::getFile(to));
+        *out++ = (char)('1' + Position::getRank(to));
+
+        if (move.getFlag() == Move::PROMOTION)
+        {
+            *out++ = '=';
+            *out++ = Notation::pieceToChar(move.getPromotion());
+        }
+    }
+
+    // the move is played on a copy to see if it checks or mates
+    Position after = position;
+    Position::Undo undo;
+    after.makeMove(move, undo);
+    if (MoveGen::getCheckers(after))
+    {
+        *out++ = MoveGen::hasLegalMove(after) ? '+' : '#';
+    }
+
+    *out = '\0';
+    return (int)(out - buffer);
+}
+
+int Notation::toUci(Move move, char* buffer)
+{
+    char* out = buffer;
+    *out++ = (char)('a' + Position::getFile(move.getFrom()));
+    *out++ = (char)('1' + Position::getRank(move.getFrom()));
+    *out++ = (char)('a' + Position::getFile(move.getTo()));
+    *out++ = (char)('1' + Position::getRank(move.getTo()));
+    if (move.getFlag() == Move::PROMOTION)
+    {
+        *out++ = (char)(Notation::pieceToChar(move.getPromotion()) | 0x20); // lower case
+    }
+    *out = '\0';
+    return (int)(out - buffer);
+}
+
+bool Notation::parseUci(const Position& position, const char* text, int length, Move& move)
+{
+    if ((length != 4 && length != 5)
+        || text[0] < 'a' || text[0] > 'h' || text[1] < '1' || text[1] > '8'
+        || text[2] < 'a' || text[2] > 'h' || text[3] < '1' || text[3] > '8')
+    {
+        return false;
+    }
+
+    uint8_t from = Position::makeSquare(text[0] - 'a', text[1] - '1');
+    uint8_t to = Position::makeSquare(text[2] - 'a', text[3] - '1');
+    Position::PieceType promotion = length == 5 ? Position::charToPieceType(text[4]) : Position::NO_PIECE_TYPE;
+    if (length == 5 && (promotion == Position::NO_PIECE_TYPE || promotion == Position::KING || promotion == Position::PAWN))
+    {
+        return false;
+    }
+
+    MoveList moves;
+    MoveGen::generateLegalMoves(position, moves);
+    for (const Move& candidate : moves)
+    {
+        if (candidate.getFrom() == from && candidate.getTo() == to
+            && (candidate.getFlag() == Move::PROMOTION ? candidate.getPromotion() == promotion : promotion == Position::NO_PIECE_TYPE))
+        {
+            move = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Notation::parseSan(const Position& position, const char* text, int length, Move& move)
+{
+    // the text is cut down from both ends: piece letter in front, promotion and destination at the back,
+    // whatever is left in the middle is the capture mark and the disambiguation
+
+    while (length > 0 && (text[length - 1] == '+' || text[length - 1] == '#' || text[length - 1] == '!' || text[length - 1] == '?'))
+    {
+        length--;
+    }
+    if (length < 2)
+    {
+        return false;
+    }
+
+    MoveList moves;
+    MoveGen::generateLegalMoves(position, moves);
+
+    if (text[0] == 'O' || text[0] == '0')
+    {
+        bool kingside = length == 3 && (text[1] == '-' && text[2] == text[0]);
+        bool queenside = length == 5 && (text[1] == '-' && text[2] == text[0] && text[3] == '-' && text[4] == text[0]);
+        if (!kingside && !queenside)
+        {
+            return false;
+        }
+        for (const Move& candidate : moves)
+        {
+            if (candidate.getFlag() == Move::CASTLING && (candidate.getTo() > candidate.getFrom()) == kingside)
+            {
+                move = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Position::PieceType type = Position::PAWN;
+    if (text[0] == 'K' || text[0] == 'Q' || text[0] == 'R' || text[0] == 'B' || text[0] == 'N')
+    {
+        type = Position::charToPieceType(text[0]);
+        text++;
+        length--;
+    }
+
+    Position::PieceType promotion = Position::NO_PIECE_TYPE;
+    if (type == Position::PAWN && length > 2 && (text[length - 1] == 'Q' || text[length - 1] == 'R' || text[length - 1] == 'B' || text[length - 1] == 'N'))
+    {
+        promotion = Position::charToPieceType(text[length - 1]);
+        length--;
+        if (text[length - 1] == '=')
+        {
+            length--;
+        }
+    }
+
+    if (length < 2 || text[length - 2] < 'a' || text[length - 2] > 'h' || text[length - 1] < '1' || text[length - 1] > '8')
+    {
+        return false;
+    }
+    uint8_t to = Position::makeSquare(text[length - 2] - 'a', text[length - 1] - '1');
+    length -= 2;
+
+    int fromFile = -1;
+    int fromRank = -1;
+    for (int i = 0; i < length; i++)
+    {
+        if (text[i] >= 'a' && text[i] <= 'h')
+        {
+            fromFile = text[i] - 'a';
+        }
+        else if (text[i] >= '1' && text[i] <= '8')
+        {
+            fromRank = text[i] - '1';
+        }
+        else if (text[i] != 'x' && text[i] != ':' && text[i] != '-')
+        {
+            return false;
+        }
+    }
+
+    int matches = 0;
+    for (const Move& candidate : moves)
+    {
+        uint8_t from = candidate.getFrom();
+        if (candidate.getTo() != to || candidate.getFlag() == Move::CASTLING || position.getPieceTypeOn(from) != type)
+        {
+            continue;
+        }
+        if ((fromFile >= 0 && Position::getFile(from) != fromFile) || (fromRank >= 0 && Position::getRank(from) != fromRank))
+        {
+            continue;
+        }
+        if ((candidate.getFlag() == Move::PROMOTION) != (promotion != Position::NO_PIECE_TYPE)
+            || (promotion != Position::NO_PIECE_TYPE && candidate.getPromotion() != promotion))
+        {
+            continue;
+        }
+        move = candidate;
+        matches++;
+    }
+    return matches == 1;
+}
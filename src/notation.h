@@ -0,0 +1,27 @@
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include "movegen.h"
+
+// reading and writing moves as text, everything works on caller owned buffers and never allocates
+
+class Notation
+{
+public:
+    static const int MAX_SAN_LENGTH = 8; // "Qa1xb2+" or "exd8=Q#" and the terminating 0
+    static const int MAX_UCI_LENGTH = 6; // "e7e8q" and the terminating 0
+
+    // the move has to be legal in the position, the length without the terminating 0 is returned
+    static int toSan(const Position& position, Move move, char* buffer);
+    static int toUci(Move move, char* buffer); // castling is written as the king's step, like e1g1
+
+    // resolves a san move like "Nbd7", "exd6", "e8=Q+" or "O-O" against the legal moves of the position
+    // trailing check, mate and annotation marks are ignored, false if it matches no legal move or more than one
+    static bool parseSan(const Position& position, const char* text, int length, Move& move);
+    static bool parseUci(const Position& position, const char* text, int length, Move& move); // false if it isn't a legal move
+
+private:
+    static char pieceToChar(Position::PieceType type) { return "RNBKQP"[type]; }
+};
+
+#endif
@@ -0,0 +1,264 @@
+#include "perft.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+// well known positions with counts that many engines agree on, picked to hit castling, en passant, promotions and pins
+const Perft::SuitePosition Perft::suite[] =
+{
+    { "initial", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609ULL },
+    { "kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603ULL },
+    { "position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083ULL },
+    { "position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5, 15833292ULL },
+    { "position 4 mirrored", "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1", 5, 15833292ULL },
+    { "position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487ULL },
+    { "position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594ULL },
+    { "en passant discovers check", "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1", 6, 1134888ULL },
+    { "en passant out of check", "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1", 6, 1440467ULL },
+    { "short castling gives check", "5k2/8/8/8/8/8/8/4K2R w K - 0 1", 6, 661072ULL },
+    { "long castling gives check", "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", 6, 803711ULL },
+    { "promotion out of check", "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1", 6, 3821001ULL },
+    { "underpromotion gives check", "8/P1k5/K7/8/8/8/8/8 w - - 0 1", 6, 92683ULL },
+    { "self stalemate", "K1k5/8/P7/8/8/8/8/8 w - - 0 1", 6, 2217ULL },
+    { "stalemate and checkmate", "8/k1P5/8/1K6/8/8/8/8 w - - 0 1", 7, 567584ULL },
+    { "double check", "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1", 4, 23527ULL },
+};
+
+const int Perft::suiteSize = sizeof(Perft::suite) / sizeof(Perft::suite[0]);
+
+uint64_t Perft::perft(Position& position, int depth, Perft::HashTable* table)
+{
+    MoveList moves;
+    MoveGen::generateLegalMoves(position, moves);
+
+    if (depth <= 1)
+    {
+        return depth == 1 ? moves.size() : 1; // bulk counting, the leaves are never played
+    }
+
+    uint64_t hash = 0;
+    uint64_t nodes = 0;
+    if (table != nullptr)
+    {
+        hash = position.hash;
+        if (table->probe(hash, depth, nodes))
+        {
+            return nodes;
+        }
+    }
+
+    for (const Move& move : moves)
+    {
+        Position::Undo undo;
+        position.makeMove(move, undo);
+        nodes += Perft::perft(position, depth - 1, table);
+        position.unmakeMove(move, undo);
+    }
+
+    if (table != nullptr)
+    {
+        table->store(hash, depth, nodes);
+    }
+    return nodes;
+}
+
+uint64_t Perft::perftParallel(const Position& position, int depth, int threads, size_t hashMegabytes)
+{
+    // the first two plies are cut into tasks and idle workers claim the next unclaimed one,
+    // the counts are added up in task order so the total doesn't depend on which thread ran what
+
+    if (threads < 2 || depth < 2)
+    {
+        Position board = position;
+        std::unique_ptr<Perft::HashTable> table = hashMegabytes > 0 ? std::make_unique<Perft::HashTable>(hashMegabytes) : nullptr;
+        return Perft::perft(board, depth, table.get());
+    }
+
+    struct Task
+    {
+        Move moves[2];
+        int count;
+        uint64_t nodes;
+    };
+
+    std::vector<Task> tasks;
+    Position root = position;
+    MoveList rootMoves;
+    MoveGen::generateLegalMoves(root, rootMoves);
+
+    for (const Move& move : rootMoves)
+    {
+        if (depth == 2)
+        {
+            tasks.push_back(Task{ { move, Move::none() }, 1, 0 });
+            continue;
+        }
+
+        Position::Undo undo;
+        root.makeMove(move, undo);
+        MoveList replies;
+        MoveGen::generateLegalMoves(root, replies);
+        for (const Move& reply : replies)
+        {
+            tasks.push_back(Task{ { move, reply }, 2, 0 });
+        }
+        root.unmakeMove(move, undo);
+    }
+
+    std::atomic<size_t> nextTask{ 0 };
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++)
+    {
+        workers.emplace_back([&]()
+        {
+            Position board = position;
+            std::unique_ptr<Perft::HashTable> table = hashMegabytes > 0 ? std::make_unique<Perft::HashTable>(hashMegabytes / threads) : nullptr;
+
+            for (size_t index = nextTask++; index < tasks.size(); index = nextTask++)
+            {
+                Task& task = tasks[index];
+                Position::Undo undos[2];
+                for (int ply = 0; ply < task.count; ply++)
+                {
+                    board.makeMove(task.moves[ply], undos[ply]);
+                }
+                task.nodes = Perft::perft(board, depth - task.count, table.get());
+                for (int ply = task.count - 1; ply >= 0; ply--)
+                {
+                    board.unmakeMove(task.moves[ply], undos[ply]);
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    uint64_t nodes = 0;
+    for (const Task& task : tasks)
+    {
+        nodes += task.nodes;
+    }
+    return nodes;
+}
+
+uint64_t Perft::divide(Position& position, int depth, Perft::HashTable* table)
+{
+    MoveList moves;
+    MoveGen::generateLegalMoves(position, moves);
+
+    uint64_t total = 0;
+    for (const Move& move : moves)
+    {
+        Position::Undo undo;
+        position.makeMove(move, undo);
+        uint64_t nodes = Perft::perft(position, depth - 1, table);
+        position.unmakeMove(move, undo);
+
+        char text[Notation::MAX_UCI_LENGTH];
+        Notation::toUci(move, text);
+        std::cout << text << ": " << nodes << "\n";
+        total += nodes;
+    }
+    std::cout << "\nmoves: " << moves.size() << "\nnodes: " << total << std::endl;
+    return total;
+}
+
+bool Perft::verifyHash(Position& position, int depth)
+{
+    if (position.hash != Zobrist::compute(position))
+    {
+        return false;
+    }
+    if (depth == 0)
+    {
+        return true;
+    }
+
+    MoveList moves;
+    MoveGen::generateLegalMoves(position, moves);
+
+    bool valid = true;
+    for (const Move& move : moves)
+    {
+        Position::Undo undo;
+        position.makeMove(move, undo);
+        valid = Perft::verifyHash(position, depth - 1);
+        position.unmakeMove(move, undo);
+        if (!valid)
+        {
+            break;
+        }
+    }
+    return valid;
+}
+
+bool Perft::runSuite(int threads, size_t hashMegabytes)
+{
+    bool passed = true;
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0.0;
+
+    for (int i = 0; i < Perft::suiteSize; i++)
+    {
+        const Perft::SuitePosition& entry = Perft::suite[i];
+        Position position;
+        position.setFromFen(entry.fen);
+
+        auto start = std::chrono::steady_clock::now();
+        uint64_t nodes = Perft::perftParallel(position, entry.depth, threads, hashMegabytes);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        bool hashValid = Perft::verifyHash(position, entry.depth < 3 ? entry.depth : 3);
+        bool ok = nodes == entry.nodes && hashValid;
+        passed = passed && ok;
+        totalNodes += nodes;
+        totalSeconds += seconds;
+
+        std::cout << (ok ? "ok    " : "FAIL  ") << entry.name << " depth " << entry.depth << ": " << nodes;
+        if (nodes != entry.nodes)
+        {
+            std::cout << " (expected " << entry.nodes << ")";
+        }
+        if (!hashValid)
+        {
+            std::cout << " (incremental hash is off)";
+        }
+        std::cout << ", " << (uint64_t)(nodes / (seconds > 0.0 ? seconds : 1e-9)) << " nps" << std::endl;
+    }
+
+    std::cout << "\n" << totalNodes << " nodes in " << totalSeconds << " s, " << (uint64_t)(totalNodes / (totalSeconds > 0.0 ? totalSeconds : 1e-9)) << " nps" << std::endl;
+    return passed;
+}
+
+Perft::HashTable::HashTable(size_t megabytes)
+{
+    size_t count = 1;
+    while (count * 2 * sizeof(Perft::HashTable::Entry) <= megabytes * 1024 * 1024)
+    {
+        count *= 2;
+    }
+    this->entries.assign(count, Perft::HashTable::Entry{ 0, 0 });
+    this->mask = count - 1;
+}
+
+bool Perft::HashTable::probe(uint64_t hash, int depth, uint64_t& nodes) const
+{
+    const Perft::HashTable::Entry& entry = this->entries[hash & this->mask];
+    if (entry.hash != hash || (int)(entry.data & 0xFF) != depth)
+    {
+        return false;
+    }
+    nodes = entry.data >> 8;
+    return true;
+}
+
+void Perft::HashTable::store(uint64_t hash, int depth, uint64_t nodes)
+{
+    Perft::HashTable::Entry& entry = this->entries[hash & this->mask];
+    entry.hash = hash;
+    entry.data = (nodes << 8) | (uint64_t)depth;
+}
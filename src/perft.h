@@ -0,0 +1,51 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+#include "notation.h"
+#include "zobrist.h"
+#include <vector>
+
+// counts the leaf nodes of the legal move tree, the standard way of testing a move generator
+
+class Perft
+{
+public:
+    struct SuitePosition
+    {
+        const char* name;
+        const char* fen;
+        int depth;
+        uint64_t nodes; // the published count for this depth
+    };
+
+    // subtree counts keyed by zobrist hash and depth, always replaces
+    class HashTable
+    {
+    public:
+        HashTable(size_t megabytes);
+
+        bool probe(uint64_t hash, int depth, uint64_t& nodes) const;
+        void store(uint64_t hash, int depth, uint64_t nodes);
+
+    private:
+        struct Entry
+        {
+            uint64_t hash;
+            uint64_t data; // node count << 8 | depth
+        };
+
+        std::vector<Entry> entries; // a power of two long, allocated once
+        uint64_t mask;
+    };
+
+    static const SuitePosition suite[];
+    static const int suiteSize;
+
+    static uint64_t perft(Position& position, int depth, Perft::HashTable* table = nullptr); // the last ply is only counted, not played
+    static uint64_t perftParallel(const Position& position, int depth, int threads, size_t hashMegabytes = 0); // every worker gets its own board and table
+    static uint64_t divide(Position& position, int depth, Perft::HashTable* table = nullptr); // prints the count under every root move
+    static bool verifyHash(Position& position, int depth); // compares the incremental key to one computed from scratch at every node
+    static bool runSuite(int threads = 1, size_t hashMegabytes = 0); // prints one line per position, false if any count is off
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include "perft.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+// headless perft tool
+//   perft                                  runs the regression suite
+//   perft <depth> [fen]                    counts the nodes of one position
+//   perft divide <depth> [fen]             same, split by root move
+// any of them can be prefixed with
+//   threads <count>                        splits the work over that many threads (not for divide)
+//   hash <megabytes>                       caches subtree counts
+
+static int printUsage()
+{
+    std::cerr << "usage: perft [threads <count>] [hash <megabytes>] [divide] <depth> [fen]" << std::endl;
+    return 2;
+}
+
+static bool parseNumber(const char* text, long min, long max, long& value)
+{
+    // the whole argument has to be a number in range, atoi would turn a typo into 0
+
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtol(text, &end, 10);
+    return end != text && *end == '\0' && errno == 0 && value >= min && value <= max;
+}
+
+int main(int argc, char* argv[])
+{
+    Attacks::init();
+
+    int argument = 1;
+    long threads = 1;
+    long hashMegabytes = 0;
+    while (argument + 1 < argc)
+    {
+        if (std::strcmp(argv[argument], "threads") == 0)
+        {
+            if (!parseNumber(argv[argument + 1], 1, 256, threads))
+            {
+                return printUsage();
+            }
+        }
+        else if (std::strcmp(argv[argument], "hash") == 0)
+        {
+            if (!parseNumber(argv[argument + 1], 0, 65536, hashMegabytes))
+            {
+                return printUsage();
+            }
+        }
+        else
+        {
+            break;
+        }
+        argument += 2;
+    }
+
+    if (argument >= argc)
+    {
+        return Perft::runSuite((int)threads, (size_t)hashMegabytes) ? 0 : 1;
+    }
+
+    bool divide = std::strcmp(argv[argument], "divide") == 0;
+    if (divide)
+    {
+        argument++;
+    }
+    long depth = 0;
+    if (argument >= argc || !parseNumber(argv[argument], 0, 64, depth))
+    {
+        return printUsage();
+    }
+
+    Position position;
+    position.setStartingPosition();
+    if (argument + 1 < argc && !position.setFromFen(argv[argument + 1]))
+    {
+        std::cerr << "invalid fen: " << argv[argument + 1] << std::endl;
+        return 2;
+    }
+
+    if (divide)
+    {
+        std::unique_ptr<Perft::HashTable> table = hashMegabytes > 0 ? std::make_unique<Perft::HashTable>((size_t)hashMegabytes) : nullptr;
+        Perft::divide(position, (int)depth, table.get());
+        return 0;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t nodes = Perft::perftParallel(position, (int)depth, (int)threads, (size_t)hashMegabytes);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "nodes: " << nodes << "\ntime: " << seconds << " s\nnps: " << (uint64_t)(nodes / (seconds > 0.0 ? seconds : 1e-9)) << std::endl;
+    return 0;
+}
@@ -0,0 +1,461 @@
+#include "pgn.h"
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+PgnReader::PgnReader()
+{
+#ifdef _WIN32
+    this->file = INVALID_HANDLE_VALUE;
+    this->mapping = nullptr;
+#else
+    this->descriptor = -1;
+#endif
+    this->view = nullptr;
+    this->viewLength = 0;
+    this->fileSize = 0;
+    this->granularity = 1;
+    this->window = nullptr;
+    this->windowLength = 0;
+    this->windowStart = 0;
+    this->cursor = 0;
+    this->state = PgnReader::NO_GAME;
+    this->result = PgnReader::UNKNOWN;
+    this->error = false;
+    this->stats = {};
+    this->position.setStartingPosition();
+}
+
+PgnReader::~PgnReader()
+{
+    this->close();
+}
+
+bool PgnReader::open(const char* path)
+{
+    this->close();
+
+#ifdef _WIN32
+    this->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER size;
+    if (this->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(this->file, &size))
+    {
+        this->close();
+        return false;
+    }
+    this->fileSize = (uint64_t)size.QuadPart;
+    if (this->fileSize > 0)
+    {
+        this->mapping = CreateFileMappingA(this->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (this->mapping == nullptr)
+        {
+            this->close();
+            return false;
+        }
+    }
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    this->granularity = info.dwAllocationGranularity;
+#else
+    this->descriptor = ::open(path, O_RDONLY);
+    struct stat status;
+    if (this->descriptor < 0 || fstat(this->descriptor, &status) != 0)
+    {
+        this->close();
+        return false;
+    }
+    this->fileSize = (uint64_t)status.st_size;
+    this->granularity = (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+
+    this->stats = {};
+    this->state = PgnReader::NO_GAME;
+    return this->mapWindow(0);
+}
+
+void PgnReader::close()
+{
+    this->unmapWindow();
+#ifdef _WIN32
+    if (this->mapping != nullptr)
+    {
+        CloseHandle(this->mapping);
+        this->mapping = nullptr;
+    }
+    if (this->file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(this->file);
+        this->file = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (this->descriptor >= 0)
+    {
+        ::close(this->descriptor);
+        this->descriptor = -1;
+    }
+#endif
+    this->fileSize = 0;
+    this->windowStart = 0;
+}
+
+bool PgnReader::nextGame()
+{
+    if (this->state == PgnReader::IN_MOVES)
+    {
+        while (this->readMove(nullptr))
+        {
+        }
+    }
+
+    this->state = PgnReader::NO_GAME;
+    this->result = PgnReader::UNKNOWN;
+    this->error = false;
+    this->position.setStartingPosition();
+
+    // tags are optional, a game starts with whatever comes first that isn't a comment
+    bool found = false;
+    for (;;)
+    {
+        this->skipWhitespace();
+        int c = this->peek();
+        if (c == '[')
+        {
+            found = true;
+            this->readTag();
+        }
+        else if (c == '{')
+        {
+            this->skipUntil('}');
+        }
+        else if (c == ';' || c == '%')
+        {
+            this->skipUntil('\n');
+        }
+        else
+        {
+            found = found || c >= 0;
+            break;
+        }
+    }
+    if (!found)
+    {
+        return false;
+    }
+
+    this->state = PgnReader::IN_MOVES;
+    this->stats.games++;
+    return true;
+}
+
+bool PgnReader::nextMove(Move& move)
+{
+    if (this->state != PgnReader::IN_MOVES || this->error)
+    {
+        return false;
+    }
+    if (this->readMove(&move))
+    {
+        return true;
+    }
+    if (!this->error)
+    {
+        this->state = PgnReader::ENDED;
+    }
+    return false;
+}
+
+bool PgnReader::mapWindow(uint64_t offset)
+{
+    this->unmapWindow();
+    this->windowStart = offset;
+    this->cursor = 0;
+    if (offset >= this->fileSize)
+    {
+        return true;
+    }
+
+    uint64_t aligned = offset - offset % this->granularity;
+    uint64_t length = PgnReader::WINDOW_SIZE + (offset - aligned);
+    if (length > this->fileSize - aligned)
+    {
+        length = this->fileSize - aligned;
+    }
+
+#ifdef _WIN32
+    this->view = MapViewOfFile(this->mapping, FILE_MAP_READ, (DWORD)(aligned >> 32), (DWORD)aligned, (SIZE_T)length);
+    if (this->view == nullptr)
+    {
+        return false;
+    }
+#else
+    void* view = mmap(nullptr, (size_t)length, PROT_READ, MAP_PRIVATE, this->descriptor, (off_t)aligned);
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+    madvise(view, (size_t)length, MADV_SEQUENTIAL); // read ahead, and the pages behind the reader can go first
+    this->view = view;
+#endif
+
+    this->viewLength = (size_t)length;
+    this->window = (const char*)this->view + (offset - aligned);
+    this->windowLength = (size_t)(length - (offset - aligned));
+    return true;
+}
+
+void PgnReader::unmapWindow()
+{
+    if (this->view != nullptr)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(this->view);
+#else
+        munmap(this->view, this->viewLength);
+#endif
+        this->view = nullptr;
+    }
+    this->viewLength = 0;
+    this->window = nullptr;
+    this->windowLength = 0;
+}
+
+bool PgnReader::ensure(size_t count)
+{
+    if (this->cursor + count <= this->windowLength)
+    {
+        return true;
+    }
+    if (this->windowStart + this->windowLength < this->fileSize && !this->mapWindow(this->windowStart + this->cursor))
+    {
+        return false; // the window couldn't be mapped, treated as the end of the file
+    }
+    return this->cursor < this->windowLength;
+}
+
+int PgnReader::peek()
+{
+    if (this->cursor < this->windowLength || this->ensure(1))
+    {
+        return (unsigned char)this->window[this->cursor];
+    }
+    return -1;
+}
+
+void PgnReader::skipWhitespace()
+{
+    for (int c = this->peek(); c == ' ' || c == '\n' || c == '\r' || c == '\t'; c = this->peek())
+    {
+        this->cursor++;
+    }
+}
+
+void PgnReader::skipUntil(char end)
+{
+    while (this->ensure(1))
+    {
+        const char* found = (const char*)std::memchr(this->window + this->cursor, end, this->windowLength - this->cursor);
+        if (found != nullptr)
+        {
+            this->cursor = (size_t)(found - this->window) + 1;
+            return;
+        }
+        this->cursor = this->windowLength;
+    }
+}
+
+void PgnReader::skipVariation()
+{
+    // variations nest, and a comment inside one may hold brackets of its own
+
+    this->cursor++;
+    int depth = 1;
+    for (int c = this->peek(); c >= 0; c = this->peek())
+    {
+        this->cursor++;
+        if (c == '(')
+        {
+            depth++;
+        }
+        else if (c == ')' && --depth == 0)
+        {
+            return;
+        }
+        else if (c == '{')
+        {
+            this->skipUntil('}');
+        }
+        else if (c == ';')
+        {
+            this->skipUntil('\n');
+        }
+    }
+}
+
+const char* PgnReader::readToken(int& length)
+{
+    // the token is left in the mapping, the pointer is good until the next read
+
+    this->ensure(PgnReader::MAX_TOKEN);
+    const char* token = this->window + this->cursor;
+    size_t limit = this->windowLength - this->cursor;
+    if (limit > PgnReader::MAX_TOKEN - 1)
+    {
+        limit = PgnReader::MAX_TOKEN - 1;
+    }
+
+    length = 0;
+    while ((size_t)length < limit && !std::strchr(" \n\r\t{}()[];$\"", token[length]))
+    {
+        length++;
+    }
+    this->cursor += length;
+    return token;
+}
+
+bool PgnReader::readTag()
+{
+    // [Name "value"], only FEN matters here, its value is the one thing copied out of the mapping
+
+    this->cursor++;
+    this->skipWhitespace();
+    int length;
+    const char* name = this->readToken(length);
+    bool fen = length == 3 && std::memcmp(name, "FEN", 3) == 0;
+
+    this->skipWhitespace();
+    if (this->peek() != '"')
+    {
+        this->skipUntil(']');
+        return false;
+    }
+    this->cursor++;
+
+    char value[Position::MAX_FEN_LENGTH];
+    int valueLength = 0;
+    for (int c = this->peek(); c >= 0 && c != '"'; c = this->peek())
+    {
+        this->cursor++;
+        if (c == '\\')
+        {
+            c = this->peek();
+            if (c < 0)
+            {
+                break;
+            }
+            this->cursor++;
+        }
+        if (valueLength < Position::MAX_FEN_LENGTH - 1)
+        {
+            value[valueLength++] = (char)c;
+        }
+    }
+    value[valueLength] = '\0';
+    this->skipUntil(']');
+
+    if (fen && !this->position.setFromFen(value) && !this->error)
+    {
+        this->error = true;
+        this->stats.errors++;
+    }
+    return true;
+}
+
+bool PgnReader::readMove(Move* move)
+{
+    for (;;)
+    {
+        this->skipWhitespace();
+        switch (this->peek())
+        {
+            case -1:
+            case '[': // the next game's tags, this one had no result
+                return false;
+            case '{':
+                this->skipUntil('}');
+                continue;
+            case ';':
+            case '%':
+                this->skipUntil('\n');
+                continue;
+            case '(':
+                this->skipVariation();
+                continue;
+            case '*':
+                this->cursor++;
+                this->result = PgnReader::UNKNOWN;
+                return false;
+            case ')':
+            case '}':
+            case ']':
+            case '"':
+            case '\0':
+            case '$': // the number of a nag is read as a token below and dropped
+                this->cursor++;
+                continue;
+        }
+
+        int length;
+        const char* token = this->readToken(length);
+
+        if (token[0] >= '0' && token[0] <= '9' && !(length >= 3 && std::memcmp(token, "0-0", 3) == 0))
+        {
+            if (length == 3 && std::memcmp(token, "1-0", 3) == 0)
+            {
+                this->result = PgnReader::WHITE_WINS;
+                return false;
+            }
+            if (length == 3 && std::memcmp(token, "0-1", 3) == 0)
+            {
+                this->result = PgnReader::BLACK_WINS;
+                return false;
+            }
+            if (length == 7 && std::memcmp(token, "1/2-1/2", 7) == 0)
+            {
+                this->result = PgnReader::DRAW;
+                return false;
+            }
+
+            // a move number, "12." or "12..." and sometimes glued to the move as in "12.e4"
+            int skipped = 0;
+            while (skipped < length && ((token[skipped] >= '0' && token[skipped] <= '9') || token[skipped] == '.'))
+            {
+                skipped++;
+            }
+            token += skipped;
+            length -= skipped;
+        }
+        while (length > 0 && token[0] == '.')
+        {
+            token++;
+            length--;
+        }
+        if (length == 4 && std::memcmp(token, "e.p.", 4) == 0)
+        {
+            continue; // some writers mark en passant captures
+        }
+        if (length == 0 || move == nullptr)
+        {
+            continue;
+        }
+
+        if (!Notation::parseSan(this->position, token, length, *move))
+        {
+            this->error = true;
+            this->stats.errors++;
+            return false;
+        }
+        Position::Undo undo;
+        this->position.makeMove(*move, undo);
+        this->stats.moves++;
+        return true;
+    }
+}
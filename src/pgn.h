@@ -0,0 +1,91 @@
+#ifndef PGN_H
+#define PGN_H
+
+#include "notation.h"
+
+// streams the games of a pgn file through the move generator
+// the file is memory mapped a window at a time, so memory use stays the same whatever the size of the file,
+// and tokens are read straight out of the mapping without copying them into strings
+
+class PgnReader
+{
+public:
+    static const size_t WINDOW_SIZE = 16 << 20; // bytes mapped at once
+    static const int MAX_TOKEN = 256; // a token is never split over two windows, nothing in a sane pgn comes close
+
+    enum Result
+    {
+        WHITE_WINS = 0,
+        BLACK_WINS = 1,
+        DRAW = 2,
+        UNKNOWN = 3 // "*" or no result at all
+    };
+
+    struct Stats
+    {
+        uint64_t games;
+        uint64_t moves;
+        uint64_t errors; // games with a bad fen or a move that isn't legal, the rest of such a game is skipped
+    };
+
+    Position position; // the board of the current game, after the last move nextMove returned
+
+    PgnReader();
+    ~PgnReader();
+    PgnReader(const PgnReader&) = delete;
+    PgnReader& operator=(const PgnReader&) = delete;
+
+    bool open(const char* path);
+    void close();
+
+    bool nextGame(); // skips what is left of the current game and sets up the next one from its tags, false at the end of the file
+    bool nextMove(Move& move); // plays the next move on position, false at the end of the game or on a move that can't be read
+
+    bool hasError() const { return this->error; }
+    PgnReader::Result getResult() const { return this->result; }
+    const PgnReader::Stats& getStats() const { return this->stats; }
+    uint64_t getFileSize() const { return this->fileSize; }
+
+private:
+    enum GameState
+    {
+        NO_GAME = 0,
+        IN_MOVES = 1,
+        ENDED = 2
+    };
+
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#else
+    int descriptor;
+#endif
+    void* view;
+    size_t viewLength;
+    uint64_t fileSize;
+    uint64_t granularity; // mappings have to start at a multiple of this
+
+    const char* window; // the mapped bytes, window[0] is at windowStart in the file
+    size_t windowLength;
+    uint64_t windowStart;
+    size_t cursor; // into window
+
+    PgnReader::GameState state;
+    PgnReader::Result result;
+    bool error;
+    PgnReader::Stats stats;
+
+    bool mapWindow(uint64_t offset);
+    void unmapWindow();
+    bool ensure(size_t count); // remaps if fewer than count bytes are left in the window, false only at the end of the file
+    int peek(); // the next byte, -1 at the end of the file
+
+    void skipWhitespace();
+    void skipUntil(char end); // consumes the end char too
+    void skipVariation();
+    const char* readToken(int& length); // until whitespace or a char that starts something else, at most MAX_TOKEN - 1 chars
+    bool readTag();
+    bool readMove(Move* move); // nullptr only skips, false once the movetext ends
+};
+
+#endif
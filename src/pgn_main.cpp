@@ -0,0 +1,44 @@
+#include "pgn.h"
+#include <chrono>
+#include <iostream>
+
+// headless pgn tool
+//   pgn <file>                             replays every game of the file and prints how fast it went
+
+int main(int argc, char* argv[])
+{
+    Attacks::init();
+
+    if (argc < 2)
+    {
+        std::cerr << "usage: pgn <file>" << std::endl;
+        return 2;
+    }
+
+    PgnReader reader;
+    if (!reader.open(argv[1]))
+    {
+        std::cerr << "can't open " << argv[1] << std::endl;
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Move move;
+    while (reader.nextGame())
+    {
+        while (reader.nextMove(move))
+        {
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (seconds <= 0.0)
+    {
+        seconds = 1e-9;
+    }
+
+    const PgnReader::Stats& stats = reader.getStats();
+    std::cout << "games: " << stats.games << "\nmoves: " << stats.moves << "\nerrors: " << stats.errors
+        << "\ntime: " << seconds << " s\ngames/s: " << (uint64_t)(stats.games / seconds) << "\nmoves/s: " << (uint64_t)(stats.moves / seconds)
+        << "\nMB/s: " << reader.getFileSize() / seconds / (1 << 20) << std::endl;
+    return stats.errors == 0 ? 0 : 1;
+}
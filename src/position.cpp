@@ -0,0 +1,537 @@
+#include "attacks.h"
+#include "move.h"
+#include "zobrist.h"
+
+void Position::clear()
+{
+    for (auto& side : this->pieces)
+    {
+        for (auto& mask : side)
+        {
+            mask = 0;
+        }
+    }
+    for (auto& side : this->pieceCounts)
+    {
+        for (auto& count : side)
+        {
+            count = 0;
+        }
+    }
+    this->sideToMove = Position::WHITE;
+    this->castlingRights = 0;
+    this->enpassantSquare = Position::NO_SQUARE;
+    this->halfmoveClock = 0;
+    this->fullmoveNumber = 1;
+    this->hash = 0;
+}
+
+void Position::setStartingPosition()
+{
+    const Position::PieceType backRank[8] = { Position::ROOK, Position::KNIGHT, Position::BISHOP, Position::QUEEN, Position::KING, Position::BISHOP, Position::KNIGHT, Position::ROOK };
+
+    this->clear();
+    for (uint8_t file = 0; file < 8; file++)
+    {
+        this->putPiece(Position::WHITE, backRank[file], Position::makeSquare(file, 0));
+        this->putPiece(Position::WHITE, Position::PAWN, Position::makeSquare(file, 1));
+        this->putPiece(Position::BLACK, Position::PAWN, Position::makeSquare(file, 6));
+        this->putPiece(Position::BLACK, backRank[file], Position::makeSquare(file, 7));
+    }
+    this->castlingRights = Position::ALL_CASTLING;
+    this->hash = Zobrist::compute(*this);
+}
+
+bool Position::setFromFen(const char* fen)
+{
+    // the fields after the en passant square are optional, the clocks default to 0 and 1
+
+    Position parsed;
+    parsed.clear();
+
+    int file = 0;
+    int rank = 7;
+    for (; *fen != ' '; fen++)
+    {
+        if (*fen == '\0')
+        {
+            return false;
+        }
+        else if (*fen == '/')
+        {
+            if (file != 8 || rank == 0)
+            {
+                return false;
+            }
+            file = 0;
+            rank--;
+        }
+        else if (*fen >= '1' && *fen <= '8')
+        {
+            file += *fen - '0';
+        }
+        else
+        {
+            Position::PieceType type = Position::charToPieceType(*fen);
+            if (type == Position::NO_PIECE_TYPE || file > 7)
+            {
+                return false;
+            }
+            Position::Color color = (*fen >= 'a') ? Position::BLACK : Position::WHITE;
+            parsed.putPiece(color, type, Position::makeSquare(file, rank));
+            file++;
+        }
+
+        if (file > 8)
+        {
+            return false;
+        }
+    }
+    if (file != 8 || rank != 0)
+    {
+        return false;
+    }
+    if (parsed.pieceCounts[Position::WHITE][Position::KING] != 1 || parsed.pieceCounts[Position::BLACK][Position::KING] != 1)
+    {
+        return false;
+    }
+    if ((parsed.pieces[Position::WHITE][Position::PAWN] | parsed.pieces[Position::BLACK][Position::PAWN]) & 0xFF000000000000FFULL)
+    {
+        return false; // a pawn on the first or last rank
+    }
+
+    fen++;
+    if (*fen != 'w' && *fen != 'b')
+    {
+        return false;
+    }
+    parsed.sideToMove = *fen == 'w' ? Position::WHITE : Position::BLACK;
+    fen++;
+    if (parsed.isKingAttacked(Position::getOpposingColor((Position::Color)parsed.sideToMove)))
+    {
+        return false; // the side that just moved can't have left its king in check
+    }
+
+    if (*fen++ != ' ')
+    {
+        return false;
+    }
+    for (; *fen != ' ' && *fen != '\0'; fen++)
+    {
+        switch (*fen)
+        {
+            case 'K': parsed.castlingRights |= Position::WHITE_KINGSIDE; break;
+            case 'Q': parsed.castlingRights |= Position::WHITE_QUEENSIDE; break;
+            case 'k': parsed.castlingRights |= Position::BLACK_KINGSIDE; break;
+            case 'q': parsed.castlingRights |= Position::BLACK_QUEENSIDE; break;
+            case '-': break;
+            default: return false;
+        }
+    }
+
+    if (*fen++ != ' ')
+    {
+        return false;
+    }
+    if (*fen == '-')
+    {
+        fen++;
+    }
+    else if (fen[0] >= 'a' && fen[0] <= 'h' && fen[1] == (parsed.sideToMove == Position::WHITE ? '6' : '3'))
+    {
+        parsed.enpassantSquare = Position::makeSquare(fen[0] - 'a', fen[1] - '1');
+        fen += 2;
+    }
+    else
+    {
+        return false;
+    }
+
+    // an en passant square nobody can take on is dropped, so the hash matches the same position reached by moves
+    // the same goes for castling rights whose king or rook has left its square
+    Position::Color them = Position::getOpposingColor((Position::Color)parsed.sideToMove);
+    uint8_t pushedPawn = parsed.enpassantSquare ^ 8;
+    if (parsed.enpassantSquare != Position::NO_SQUARE
+        && (!(parsed.pieces[them][Position::PAWN] & Position::squareMask(pushedPawn)) || !parsed.canCaptureEnpassant(parsed.enpassantSquare, (Position::Color)parsed.sideToMove)))
+    {
+        parsed.enpassantSquare = Position::NO_SQUARE;
+    }
+    const uint8_t rookSquares[4] = { 0, 7, 56, 63 };
+    for (uint8_t square : rookSquares)
+    {
+        Position::Color color = square < 8 ? Position::WHITE : Position::BLACK;
+        if (!(parsed.pieces[color][Position::ROOK] & Position::squareMask(square)) || !(parsed.pieces[color][Position::KING] & Position::squareMask((square & 56) | 4)))
+        {
+            parsed.castlingRights &= ~Position::getCastlingRightsOn(square);
+        }
+    }
+
+    int clocks[2] = { 0, 1 };
+    for (int& clock : clocks)
+    {
+        while (*fen == ' ')
+        {
+            fen++;
+        }
+        if (*fen < '0' || *fen > '9')
+        {
+            break;
+        }
+        clock = 0;
+        for (; *fen >= '0' && *fen <= '9'; fen++)
+        {
+            if (clock < 100000) // any longer run of digits is clamped below, it can't overflow on the way
+            {
+                clock = clock * 10 + (*fen - '0');
+            }
+        }
+    }
+    parsed.halfmoveClock = (uint8_t)(clocks[0] > 255 ? 255 : clocks[0]);
+    parsed.fullmoveNumber = (uint16_t)(clocks[1] < 1 ? 1 : (clocks[1] > 65535 ? 65535 : clocks[1]));
+    parsed.hash = Zobrist::compute(parsed);
+
+    *this = parsed;
+    return true;
+}
+
+int Position::toFen(char* buffer) const
+{
+    // buffer must hold Position::MAX_FEN_LENGTH chars, the length without the terminating 0 is returned
+
+    const char letters[2][6] = { { 'R', 'N', 'B', 'K', 'Q', 'P' }, { 'r', 'n', 'b', 'k', 'q', 'p' } };
+    char* out = buffer;
+
+    for (int rank = 7; rank >= 0; rank--)
+    {
+        int empty = 0;
+        for (uint8_t file = 0; file < 8; file++)
+        {
+            uint8_t square = Position::makeSquare(file, (uint8_t)rank);
+            Position::Color color = this->getColorOn(square);
+            if (color == Position::NO_COLOR)
+            {
+                empty++;
+                continue;
+            }
+            if (empty)
+            {
+                *out++ = (char)('0' + empty);
+                empty = 0;
+            }
+            *out++ = letters[color][this->getPieceTypeOn(square)];
+        }
+        if (empty)
+        {
+            *out++ = (char)('0' + empty);
+        }
+        if (rank)
+        {
+            *out++ = '/';
+        }
+    }
+
+    *out++ = ' ';
+    *out++ = this->sideToMove == Position::WHITE ? 'w' : 'b';
+    *out++ = ' ';
+    if (!this->castlingRights)
+    {
+        *out++ = '-';
+    }
+    const char castlingLetters[4] = { 'K', 'Q', 'k', 'q' };
+    for (int right = 0; right < 4; right++)
+    {
+        if (this->castlingRights & (1 << right))
+        {
+            *out++ = castlingLetters[right];
+        }
+    }
+
+    *out++ = ' ';
+    if (this->enpassantSquare == Position::NO_SQUARE)
+    {
+        *out++ = '-';
+    }
+    else
+    {
+        *out++ = (char)('a' + Position::getFile(this->enpassantSquare));
+        *out++ = (char)('1' + Position::getRank(this->enpassantSquare));
+    }
+
+    unsigned clocks[2] = { this->halfmoveClock, this->fullmoveNumber };
+    for (unsigned clock : clocks)
+    {
+        char digits[5];
+        int count = 0;
+        do
+        {
+            digits[count++] = (char)('0' + clock % 10);
+            clock /= 10;
+        } while (clock);
+
+        *out++ = ' ';
+        while (count)
+        {
+            *out++ = digits[--count];
+        }
+    }
+
+    *out = '\0';
+    return (int)(out - buffer);
+}
+
+bool Position::isKingAttacked(Position::Color color) const
+{
+    uint8_t king = this->getKingSquare(color);
+    Position::Color them = Position::getOpposingColor(color);
+    uint64_t occupied = this->getOccupancy();
+    const uint64_t* theirs = this->pieces[them];
+
+    return (Attacks::getPawnAttacks(color, king) & theirs[Position::PAWN])
+        || (Attacks::getKnightAttacks(king) & theirs[Position::KNIGHT])
+        || (Attacks::getKingAttacks(king) & theirs[Position::KING])
+        || (Attacks::getRookAttacks(king, occupied) & (theirs[Position::ROOK] | theirs[Position::QUEEN]))
+        || (Attacks::getBishopAttacks(king, occupied) & (theirs[Position::BISHOP] | theirs[Position::QUEEN]));
+}
+
+void Position::putPiece(Position::Color color, Position::PieceType type, uint8_t square)
+{
+    this->pieces[color][type] |= Position::squareMask(square);
+    this->pieceCounts[color][type]++;
+    this->hash ^= Zobrist::keys.pieces[color][type][square];
+}
+
+void Position::removePiece(Position::Color color, Position::PieceType type, uint8_t square)
+{
+    this->pieces[color][type] &= ~Position::squareMask(square);
+    this->pieceCounts[color][type]--;
+    this->hash ^= Zobrist::keys.pieces[color][type][square];
+}
+
+void Position::movePiece(Position::Color color, Position::PieceType type, uint8_t from, uint8_t to)
+{
+    this->pieces[color][type] ^= Position::squareMask(from) | Position::squareMask(to);
+    this->hash ^= Zobrist::keys.pieces[color][type][from] ^ Zobrist::keys.pieces[color][type][to];
+}
+
+void Position::makeMove(Move move, Position::Undo& undo)
+{
+    // plays a legal move, undo gets everything unmakeMove needs to take it back
+
+    uint8_t from = move.getFrom();
+    uint8_t to = move.getTo();
+    Position::Color us = (Position::Color)this->sideToMove;
+    Position::Color them = Position::getOpposingColor(us);
+    Position::PieceType type = this->getPieceTypeOn(from);
+
+    undo.hash = this->hash;
+    undo.castlingRights = this->castlingRights;
+    undo.enpassantSquare = this->enpassantSquare;
+    undo.halfmoveClock = this->halfmoveClock;
+    undo.captured = Position::NO_PIECE_TYPE;
+
+    if (this->halfmoveClock < 255) // saturates, a wrap to 0 would take the fifty move draw away; unmakeMove restores it from undo
+    {
+        this->halfmoveClock++;
+    }
+
+    if (move.getFlag() == Move::EN_PASSANT)
+    {
+        this->removePiece(them, Position::PAWN, to ^ 8); // the captured pawn is one rank behind the en passant square
+        undo.captured = Position::PAWN;
+    }
+    else if (this->getOccupancy(them) & Position::squareMask(to))
+    {
+        undo.captured = this->getPieceTypeOn(to);
+        this->removePiece(them, (Position::PieceType)undo.captured, to);
+    }
+
+    if (type == Position::PAWN || undo.captured != Position::NO_PIECE_TYPE)
+    {
+        this->halfmoveClock = 0;
+    }
+
+    this->movePiece(us, type, from, to);
+
+    if (move.getFlag() == Move::PROMOTION)
+    {
+        this->removePiece(us, Position::PAWN, to);
+        this->putPiece(us, move.getPromotion(), to);
+    }
+    else if (move.getFlag() == Move::CASTLING)
+    {
+        // the rook jumps to the other side of the king
+        bool kingside = to > from;
+        this->movePiece(us, Position::ROOK, kingside ? from + 3 : from - 4, kingside ? from + 1 : from - 1);
+    }
+
+    if (this->enpassantSquare != Position::NO_SQUARE)
+    {
+        this->hash ^= Zobrist::keys.enpassantFile[Position::getFile(this->enpassantSquare)];
+        this->enpassantSquare = Position::NO_SQUARE;
+    }
+    if (type == Position::PAWN && (from ^ to) == 16 && this->canCaptureEnpassant((from + to) / 2, them))
+    {
+        this->enpassantSquare = (from + to) / 2;
+        this->hash ^= Zobrist::keys.enpassantFile[Position::getFile(this->enpassantSquare)];
+    }
+
+    this->hash ^= Zobrist::keys.castling[this->castlingRights];
+    this->castlingRights &= ~(Position::getCastlingRightsOn(from) | Position::getCastlingRightsOn(to));
+    this->hash ^= Zobrist::keys.castling[this->castlingRights];
+
+    if (us == Position::BLACK)
+    {
+        this->fullmoveNumber++;
+    }
+    this->sideToMove = them;
+    this->hash ^= Zobrist::keys.blackToMove;
+}
+
+void Position::unmakeMove(Move move, const Position::Undo& undo)
+{
+    uint8_t from = move.getFrom();
+    uint8_t to = move.getTo();
+    Position::Color them = (Position::Color)this->sideToMove;
+    Position::Color us = Position::getOpposingColor(them);
+
+    this->sideToMove = us;
+    if (us == Position::BLACK)
+    {
+        this->fullmoveNumber--;
+    }
+
+    if (move.getFlag() == Move::PROMOTION)
+    {
+        this->removePiece(us, move.getPromotion(), to);
+        this->putPiece(us, Position::PAWN, to);
+    }
+    else if (move.getFlag() == Move::CASTLING)
+    {
+        bool kingside = to > from;
+        this->movePiece(us, Position::ROOK, kingside ? from + 1 : from - 1, kingside ? from + 3 : from - 4);
+    }
+
+    this->movePiece(us, this->getPieceTypeOn(to), to, from);
+
+    if (move.getFlag() == Move::EN_PASSANT)
+    {
+        this->putPiece(them, Position::PAWN, to ^ 8);
+    }
+    else if (undo.captured != Position::NO_PIECE_TYPE)
+    {
+        this->putPiece(them, (Position::PieceType)undo.captured, to);
+    }
+
+    this->hash = undo.hash;
+    this->castlingRights = undo.castlingRights;
+    this->enpassantSquare = undo.enpassantSquare;
+    this->halfmoveClock = undo.halfmoveClock;
+}
+
+bool Position::canCaptureEnpassant(uint8_t square, Position::Color by) const
+{
+    // only whether a pawn stands next to it, a pin on that pawn still counts
+    return (Attacks::getPawnAttacks(Position::getOpposingColor(by), square) & this->pieces[by][Position::PAWN]) != 0;
+}
+
+bool Position::isInsufficientMaterial() const
+{
+    // true when neither side could mate even with the other side's help:
+    // bare kings, a single minor piece, or only bishops that all stand on the same color
+
+    const uint64_t darkSquares = 0xAA55AA55AA55AA55ULL;
+    const uint8_t (&white)[6] = this->pieceCounts[Position::WHITE];
+    const uint8_t (&black)[6] = this->pieceCounts[Position::BLACK];
+
+    if (white[Position::PAWN] + black[Position::PAWN] + white[Position::ROOK] + black[Position::ROOK] + white[Position::QUEEN] + black[Position::QUEEN] > 0)
+    {
+        return false;
+    }
+
+    int knights = white[Position::KNIGHT] + black[Position::KNIGHT];
+    int bishops = white[Position::BISHOP] + black[Position::BISHOP];
+    if (knights + bishops <= 1)
+    {
+        return true;
+    }
+    if (knights > 0)
+    {
+        return false;
+    }
+
+    uint64_t allBishops = this->pieces[Position::WHITE][Position::BISHOP] | this->pieces[Position::BLACK][Position::BISHOP];
+    return (allBishops & darkSquares) == 0 || (allBishops & ~darkSquares) == 0;
+}
+
+Position::PieceType Position::getPieceTypeOn(uint8_t square) const
+{
+    uint64_t mask = Position::squareMask(square);
+    for (uint8_t type = Position::ROOK; type < Position::NO_PIECE_TYPE; type++)
+    {
+        if ((this->pieces[Position::WHITE][type] | this->pieces[Position::BLACK][type]) & mask)
+        {
+            return (Position::PieceType)type;
+        }
+    }
+    return Position::NO_PIECE_TYPE;
+}
+
+Position::Color Position::getColorOn(uint8_t square) const
+{
+    uint64_t mask = Position::squareMask(square);
+    if (this->getOccupancy(Position::WHITE) & mask)
+    {
+        return Position::WHITE;
+    }
+    else if (this->getOccupancy(Position::BLACK) & mask)
+    {
+        return Position::BLACK;
+    }
+    return Position::NO_COLOR;
+}
+
+uint64_t Position::getOccupancy(Position::Color color) const
+{
+    const uint64_t* side = this->pieces[color];
+    return side[0] | side[1] | side[2] | side[3] | side[4] | side[5];
+}
+
+uint64_t Position::getOccupancy() const
+{
+    return this->getOccupancy(Position::WHITE) | this->getOccupancy(Position::BLACK);
+}
+
+uint8_t Position::getKingSquare(Position::Color color) const
+{
+    return Position::lsb(this->pieces[color][Position::KING]);
+}
+
+Position::PieceType Position::charToPieceType(char letter)
+{
+    switch (letter | 0x20) // lower case
+    {
+        case 'r': return Position::ROOK;
+        case 'n': return Position::KNIGHT;
+        case 'b': return Position::BISHOP;
+        case 'k': return Position::KING;
+        case 'q': return Position::QUEEN;
+        case 'p': return Position::PAWN;
+        default: return Position::NO_PIECE_TYPE;
+    }
+}
+
+uint8_t Position::getCastlingRightsOn(uint8_t square)
+{
+    // the rights that are lost when something moves from or to this square
+
+    switch (square)
+    {
+        case 0: return Position::WHITE_QUEENSIDE;
+        case 4: return Position::WHITE_KINGSIDE | Position::WHITE_QUEENSIDE;
+        case 7: return Position::WHITE_KINGSIDE;
+        case 56: return Position::BLACK_QUEENSIDE;
+        case 60: return Position::BLACK_KINGSIDE | Position::BLACK_QUEENSIDE;
+        case 63: return Position::BLACK_KINGSIDE;
+        default: return 0;
+    }
+}
@@ -0,0 +1,124 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+class Move;
+
+// squares are numbered a1 = 0, b1 = 1 ... h8 = 63
+// tiles are the board's drawing order: a8 = 0 (top left) ... h1 = 63 (bottom right)
+
+class Position
+{
+public:
+    enum Color
+    {
+        WHITE = 0,
+        BLACK = 1,
+        NO_COLOR = 2
+    };
+
+    enum PieceType // same order as Objects::PieceName so the two can be cast into each other
+    {
+        ROOK = 0,
+        KNIGHT = 1,
+        BISHOP = 2,
+        KING = 3,
+        QUEEN = 4,
+        PAWN = 5,
+        NO_PIECE_TYPE = 6
+    };
+
+    enum CastlingRights
+    {
+        WHITE_KINGSIDE = 1,
+        WHITE_QUEENSIDE = 2,
+        BLACK_KINGSIDE = 4,
+        BLACK_QUEENSIDE = 8,
+        ALL_CASTLING = 15
+    };
+
+    static const uint8_t NO_SQUARE = 64;
+    static const int MAX_FEN_LENGTH = 96; // the longest fen toFen can write, the terminating 0 included
+
+    struct Undo // what unmakeMove can't work out from the move itself
+    {
+        uint64_t hash;
+        uint8_t captured; // a Position::PieceType, NO_PIECE_TYPE if nothing was taken
+        uint8_t castlingRights;
+        uint8_t enpassantSquare;
+        uint8_t halfmoveClock;
+    };
+
+    uint64_t pieces[2][6];
+    uint8_t pieceCounts[2][6]; // follows pieces, so material questions don't need a popcount
+    uint64_t hash; // zobrist key, kept up to date by every change to the position
+    uint8_t sideToMove;
+    uint8_t castlingRights;
+    uint8_t enpassantSquare; // only set when a pawn of the side to move could take there
+    uint8_t halfmoveClock;
+    uint16_t fullmoveNumber;
+
+    void clear();
+    void setStartingPosition();
+    bool setFromFen(const char* fen); // leaves the position untouched if the fen is malformed
+    int toFen(char* buffer) const;
+
+    void putPiece(Position::Color color, Position::PieceType type, uint8_t square);
+    void removePiece(Position::Color color, Position::PieceType type, uint8_t square);
+    void movePiece(Position::Color color, Position::PieceType type, uint8_t from, uint8_t to);
+    void makeMove(Move move, Position::Undo& undo);
+    void unmakeMove(Move move, const Position::Undo& undo);
+
+    Position::PieceType getPieceTypeOn(uint8_t square) const;
+    Position::Color getColorOn(uint8_t square) const;
+    uint64_t getOccupancy(Position::Color color) const;
+    uint64_t getOccupancy() const;
+    uint8_t getKingSquare(Position::Color color) const;
+    bool canCaptureEnpassant(uint8_t square, Position::Color by) const;
+    bool isKingAttacked(Position::Color color) const;
+    bool isInsufficientMaterial() const;
+
+    static uint8_t getCastlingRightsOn(uint8_t square);
+    static Position::PieceType charToPieceType(char letter); // either case, NO_PIECE_TYPE if it's not a piece letter
+    static Position::Color getOpposingColor(Position::Color color) { return (Position::Color)(color ^ 1); }
+    static uint8_t makeSquare(uint8_t file, uint8_t rank) { return (uint8_t)(rank * 8 + file); }
+    static uint8_t getFile(uint8_t square) { return square & 7; }
+    static uint8_t getRank(uint8_t square) { return square >> 3; }
+    static uint8_t squareToTile(uint8_t square) { return square ^ 56; }
+    static uint8_t tileToSquare(uint8_t tile) { return tile ^ 56; }
+    static uint64_t squareMask(uint8_t square) { return 1ULL << square; }
+
+    static int popCount(uint64_t mask)
+    {
+#ifdef _MSC_VER
+        return (int)__popcnt64(mask);
+#else
+        return __builtin_popcountll(mask);
+#endif
+    }
+
+    static uint8_t lsb(uint64_t mask) // mask must not be empty
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return (uint8_t)index;
+#else
+        return (uint8_t)__builtin_ctzll(mask);
+#endif
+    }
+
+    static uint8_t popLsb(uint64_t& mask)
+    {
+        uint8_t square = Position::lsb(mask);
+        mask &= mask - 1;
+        return square;
+    }
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef REPETITION_H
+#define REPETITION_H
+
+#include <cstdint>
+
+// hashes of the positions before the current one, only the last SIZE are kept
+// nothing older than the last capture or pawn move can repeat, so a lookup never goes back further than the halfmove clock
+// a popped slot is only valid again as long as no push got SIZE - MAX_REACH plies past it since,
+// SIZE is big enough for the game's whole undo ring plus a search line, see the static_assert in search.h
+
+class RepetitionHistory
+{
+public:
+    static const int SIZE = 2048; // a power of two
+    static const int MAX_REACH = 255; // the most plies a lookup goes back, where the halfmove clock saturates
+
+    void clear() { this->count = 0; }
+    void push(uint64_t hash) { this->hashes[this->count++ & (RepetitionHistory::SIZE - 1)] = hash; }
+    void pop() { this->count--; }
+
+    // how many times the position with this hash stood on the board, the current one included
+    int countOccurrences(uint64_t hash, int halfmoveClock) const
+    {
+        int reach = halfmoveClock < this->count ? halfmoveClock : this->count;
+        if (reach > RepetitionHistory::MAX_REACH)
+        {
+            reach = RepetitionHistory::MAX_REACH;
+        }
+
+        int occurrences = 1;
+        for (int back = 4; back <= reach; back += 2) // the same side has to be on move, and it takes at least four plies to come back
+        {
+            if (this->hashes[(this->count - back) & (RepetitionHistory::SIZE - 1)] == hash)
+            {
+                occurrences++;
+            }
+        }
+        return occurrences;
+    }
+
+private:
+    uint64_t hashes[RepetitionHistory::SIZE];
+    int count = 0;
+};
+
+#endif
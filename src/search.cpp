@@ -0,0 +1,619 @@
+#include "search.h"
+
+Search::Search()
+{
+    this->stopRequested.store(false);
+    this->finished.store(true);
+    this->pondering.store(false);
+    this->clockStart.store(0);
+    this->bestMove = Move::none();
+    this->ponderMove = Move::none();
+    this->timeBudget = 0;
+    this->setThreads(1);
+}
+
+Search::~Search()
+{
+    this->stop();
+    this->wait();
+}
+
+void Search::start(const Game& game, const Search::Limits& limits, Search::Reporter reporter, Search::Finisher finisher)
+{
+    this->stop();
+    this->wait();
+
+    // the flag is cleared here and not on the search thread, a stop sent right after start can't get lost
+    this->stopRequested.store(false, std::memory_order_relaxed);
+    this->finished.store(false, std::memory_order_relaxed);
+    this->game = game;
+    this->limits = limits;
+    this->reporter = std::move(reporter);
+    this->finisher = std::move(finisher);
+    this->bestMove = Move::none();
+    this->ponderMove = Move::none();
+    this->startTime = std::chrono::steady_clock::now();
+    this->clockStart.store(Search::getNow(), std::memory_order_relaxed);
+    this->pondering.store(limits.ponder, std::memory_order_relaxed);
+    this->timeBudget = this->getTimeBudget();
+    this->thread = std::thread(&Search::run, this);
+}
+
+void Search::ponderhit()
+{
+    // a stray or late ponderhit must not restart the clock of a search that is already under its time limits
+    // only the thread that calls start and ponderhit ever sets pondering, so it can't turn on between the check and the store
+    if (!this->isPondering())
+    {
+        return;
+    }
+
+    // the clock restarts first, a search thread that sees pondering end must not measure from the old start
+    this->clockStart.store(Search::getNow(), std::memory_order_relaxed);
+    this->pondering.store(false, std::memory_order_release);
+}
+
+bool Search::setHashSize(size_t megabytes, bool hugePages)
+{
+    this->stop();
+    this->wait();
+    return this->table.resize(megabytes, hugePages);
+}
+
+void Search::setThreads(int count)
+{
+    this->stop();
+    this->wait();
+
+    count = count < 1 ? 1 : (count > Search::MAX_THREADS ? Search::MAX_THREADS : count);
+    this->workers.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        if (!this->workers[i])
+        {
+            this->workers[i] = std::make_unique<Search::Worker>();
+            this->workers[i]->id = i;
+        }
+    }
+}
+
+void Search::clearHash()
+{
+    this->stop();
+    this->wait();
+    this->table.clear();
+}
+
+Move Search::wait()
+{
+    if (this->thread.joinable())
+    {
+        this->thread.join();
+    }
+    return this->bestMove;
+}
+
+void Search::run()
+{
+    this->table.newSearch();
+    for (std::unique_ptr<Search::Worker>& worker : this->workers)
+    {
+        worker->position = this->game.position;
+        worker->history = this->game.history;
+        worker->nodes.store(0, std::memory_order_relaxed);
+        worker->completedDepth = 0;
+        worker->completedScore = 0;
+        worker->previousPvLength = 0;
+        for (auto& killers : worker->killers)
+        {
+            killers[0] = killers[1] = Move::none();
+        }
+    }
+
+    MoveList rootMoves;
+    MoveGen::generateLegalMoves(this->game.position, rootMoves);
+    if (rootMoves.empty())
+    {
+        if (this->finisher)
+        {
+            this->finisher(Move::none(), Move::none());
+        }
+        this->finished.store(true, std::memory_order_release);
+        return;
+    }
+    this->bestMove = rootMoves.moves[0]; // something to play even if the first depth gets cut short
+
+    for (size_t i = 1; i < this->workers.size(); i++)
+    {
+        this->helpers.emplace_back(&Search::iterate, this, std::ref(*this->workers[i]));
+    }
+    this->iterate(*this->workers[0]);
+
+    // an infinite or pondering search may not hand in its move before it's told to stop, or for pondering until ponderhit
+    while ((this->limits.infinite || this->isPondering()) && !this->isStopped())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    this->stop();
+    for (std::thread& helper : this->helpers)
+    {
+        helper.join();
+    }
+    this->helpers.clear();
+
+    // a helper that got a depth further than the main thread has the better move
+    Search::Worker* best = this->workers[0].get();
+    for (std::unique_ptr<Search::Worker>& worker : this->workers)
+    {
+        if (worker->completedDepth > best->completedDepth && worker->previousPvLength > 0)
+        {
+            best = worker.get();
+        }
+    }
+    if (best != this->workers[0].get())
+    {
+        this->bestMove = best->previousPv[0];
+        this->ponderMove = best->previousPvLength > 1 ? best->previousPv[1] : Move::none();
+        this->report(*best, best->completedDepth, best->completedScore);
+    }
+
+    if (this->finisher)
+    {
+        this->finisher(this->bestMove, this->ponderMove);
+    }
+    this->finished.store(true, std::memory_order_release);
+}
+
+void Search::iterate(Search::Worker& worker)
+{
+    // iterative deepening: every depth starts over from the root with the line of the last one tried first,
+    // a depth cut short by the limits is thrown away, except that the main thread's first one still has to give a move
+    // helpers skip depths by a pattern of their own, so at any time the threads are spread over two or three depths
+
+    const int skipSizes[20] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+    const int skipPhases[20] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    int maxDepth = this->limits.depth > 0 && this->limits.depth < Search::MAX_PLY ? this->limits.depth : Search::MAX_PLY - 1;
+    for (int depth = 1; depth <= maxDepth; depth++)
+    {
+        if (worker.id > 0)
+        {
+            int pattern = (worker.id - 1) % 20;
+            if (((depth + skipPhases[pattern]) / skipSizes[pattern]) % 2 == 1 && depth < maxDepth)
+            {
+                continue;
+            }
+        }
+
+        int score = this->negamax(worker, depth, 0, -Search::INFINITE_SCORE, Search::INFINITE_SCORE);
+        if (this->isStopped() && (worker.id > 0 || depth > 1))
+        {
+            break;
+        }
+
+        worker.completedDepth = depth;
+        worker.completedScore = score;
+        worker.previousPvLength = worker.pvLength[0];
+        for (int i = 0; i < worker.pvLength[0]; i++)
+        {
+            worker.previousPv[i] = worker.pv[0][i];
+        }
+        if (worker.id > 0)
+        {
+            continue;
+        }
+
+        if (worker.pvLength[0] > 0)
+        {
+            this->bestMove = worker.pv[0][0];
+            this->ponderMove = worker.pvLength[0] > 1 ? worker.pv[0][1] : Move::none();
+        }
+        this->report(worker, depth, score);
+
+        // another depth would most likely not finish in the time that is left, and a forced mate won't change
+        if (this->isStopped() || (this->timeBudget > 0 && this->getClockElapsed() * 2 > this->timeBudget)
+            || (!this->limits.infinite && !this->isPondering() && Search::isMateScore(score) && Search::MATE_SCORE - (score > 0 ? score : -score) <= depth))
+        {
+            break;
+        }
+    }
+}
+
+void Search::report(const Search::Worker& worker, int depth, int score)
+{
+    if (!this->reporter)
+    {
+        return;
+    }
+
+    Search::Report report;
+    report.depth = depth;
+    report.score = score;
+    report.nodes = this->getNodes();
+    report.milliseconds = this->getElapsed();
+    report.nodesPerSecond = report.nodes * 1000 / (uint64_t)(report.milliseconds > 0 ? report.milliseconds : 1);
+    report.hashfull = this->table.getHashfull();
+    report.threads = (int)this->workers.size();
+    report.pvLength = worker.previousPvLength;
+    for (int i = 0; i < report.pvLength; i++)
+    {
+        report.pv[i] = worker.previousPv[i];
+    }
+    this->reporter(report);
+}
+
+int Search::negamax(Search::Worker& worker, int depth, int ply, int alpha, int beta)
+{
+    Position& position = worker.position;
+    worker.pvLength[ply] = 0;
+
+    if (ply > 0)
+    {
+        // the same position earlier on the line or in the game counts as a draw already, so does the fifty move rule
+        if (position.halfmoveClock >= 100 || position.isInsufficientMaterial() || worker.history.countOccurrences(position.hash, position.halfmoveClock) >= 2)
+        {
+            return 0;
+        }
+        if (this->isOutOfBudget(worker))
+        {
+            return 0;
+        }
+    }
+
+    if (depth <= 0)
+    {
+        return this->quiescence(worker, ply, 0, alpha, beta);
+    }
+    worker.nodes.store(worker.nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); // only this thread writes it
+    uint64_t checkers = MoveGen::getCheckers(position);
+    if (checkers)
+    {
+        depth++; // a check inside the tree is never the end of a line
+    }
+    if (ply >= Search::MAX_PLY - 1)
+    {
+        return Evaluation::evaluate(position);
+    }
+
+    // a result from an earlier search at least as deep ends the node if its bound says enough, the root always searches
+    TranspositionTable::Entry entry;
+    Move tableMove = Move::none();
+    if (this->table.probe(position.hash, entry))
+    {
+        tableMove = entry.move;
+        entry.score = Search::scoreFromTable(entry.score, ply);
+        if (ply > 0 && entry.depth >= depth && (entry.bound == TranspositionTable::EXACT_BOUND
+            || (entry.bound == TranspositionTable::LOWER_BOUND && entry.score >= beta)
+            || (entry.bound == TranspositionTable::UPPER_BOUND && entry.score <= alpha)))
+        {
+            if (entry.bound == TranspositionTable::EXACT_BOUND && tableMove != Move::none())
+            {
+                worker.pv[ply][0] = tableMove; // the line ends here, but at least with the right move
+                worker.pvLength[ply] = 1;
+            }
+            return entry.score;
+        }
+    }
+
+    MoveList moves;
+    MoveGen::generateLegalMoves(position, moves);
+    if (moves.empty())
+    {
+        return checkers ? -Search::MATE_SCORE + ply : 0;
+    }
+
+    int scores[MoveList::CAPACITY];
+    this->scoreMoves(worker, moves, ply, tableMove, scores);
+
+    int originalAlpha = alpha;
+    int bestScore = -Search::INFINITE_SCORE;
+    Move bestMove = Move::none();
+    for (int i = 0; i < moves.size(); i++)
+    {
+        // selection sort on the fly, a cutoff usually comes long before the list is through
+        int best = i;
+        for (int j = i + 1; j < moves.size(); j++)
+        {
+            if (scores[j] > scores[best])
+            {
+                best = j;
+            }
+        }
+        Move move = moves.moves[best];
+        moves.moves[best] = moves.moves[i];
+        moves.moves[i] = move;
+        scores[best] = scores[i];
+
+        bool quiet = move.getFlag() != Move::PROMOTION && move.getFlag() != Move::EN_PASSANT && position.getColorOn(move.getTo()) == Position::NO_COLOR;
+
+        Position::Undo undo;
+        worker.history.push(position.hash);
+        position.makeMove(move, undo);
+        this->table.prefetch(position.hash);
+        int score = -this->negamax(worker, depth - 1, ply + 1, -beta, -alpha);
+        position.unmakeMove(move, undo);
+        worker.history.pop();
+
+        if (this->isStopped())
+        {
+            return 0;
+        }
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestMove = move;
+            if (score > alpha)
+            {
+                alpha = score;
+                worker.pv[ply][0] = move;
+                for (int k = 0; k < worker.pvLength[ply + 1]; k++)
+                {
+                    worker.pv[ply][k + 1] = worker.pv[ply + 1][k];
+                }
+                worker.pvLength[ply] = worker.pvLength[ply + 1] + 1;
+            }
+        }
+        if (alpha >= beta)
+        {
+            if (quiet && worker.killers[ply][0] != move)
+            {
+                worker.killers[ply][1] = worker.killers[ply][0];
+                worker.killers[ply][0] = move;
+            }
+            break;
+        }
+    }
+
+    TranspositionTable::Bound bound = bestScore >= beta ? TranspositionTable::LOWER_BOUND : (bestScore > originalAlpha ? TranspositionTable::EXACT_BOUND : TranspositionTable::UPPER_BOUND);
+    this->table.store(position.hash, bound == TranspositionTable::UPPER_BOUND ? Move::none() : bestMove, Search::scoreToTable(bestScore, ply), depth, bound);
+    return bestScore;
+}
+
+int Search::quiescence(Search::Worker& worker, int ply, int qply, int alpha, int beta)
+{
+    // only captures and promotions are searched until the position is quiet, so the evaluation never sees a piece hanging
+    // the side to move may stand pat on the static score, a capture can't be forced on it
+    // a check right at the horizon is answered with every evasion instead, standing pat there could hide a mate
+
+    Position& position = worker.position;
+    worker.pvLength[ply] = 0;
+    worker.nodes.store(worker.nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (this->isOutOfBudget(worker))
+    {
+        return 0;
+    }
+    if (position.isInsufficientMaterial())
+    {
+        return 0;
+    }
+    if (ply >= Search::MAX_PLY - 1)
+    {
+        return Evaluation::evaluate(position);
+    }
+
+    bool evading = qply == 0 && MoveGen::getCheckers(position) != 0;
+    int standPat = -Search::INFINITE_SCORE;
+    MoveList moves;
+    if (evading)
+    {
+        MoveGen::generateLegalMoves(position, moves);
+        if (moves.empty())
+        {
+            return -Search::MATE_SCORE + ply;
+        }
+    }
+    else
+    {
+        standPat = Evaluation::evaluate(position);
+        if (standPat >= beta)
+        {
+            return standPat;
+        }
+        if (standPat > alpha)
+        {
+            alpha = standPat;
+        }
+        MoveGen::generateCaptures(position, moves);
+    }
+
+    int scores[MoveList::CAPACITY];
+    this->scoreMoves(worker, moves, ply, Move::none(), scores);
+
+    int bestScore = standPat;
+    for (int i = 0; i < moves.size(); i++)
+    {
+        int best = i;
+        for (int j = i + 1; j < moves.size(); j++)
+        {
+            if (scores[j] > scores[best])
+            {
+                best = j;
+            }
+        }
+        Move move = moves.moves[best];
+        moves.moves[best] = moves.moves[i];
+        moves.moves[i] = move;
+        scores[best] = scores[i];
+
+        if (!evading)
+        {
+            // a knight is as good as a queen only where the queen would stalemate or be lost, not worth the nodes here
+            if (move.getFlag() == Move::PROMOTION && move.getPromotion() != Position::QUEEN)
+            {
+                continue;
+            }
+
+            // delta pruning: even winning the piece and some positional margin on top can't lift the score to alpha
+            Position::PieceType victim = move.getFlag() == Move::EN_PASSANT ? Position::PAWN : position.getPieceTypeOn(move.getTo());
+            int gain = victim == Position::NO_PIECE_TYPE ? 0 : Evaluation::pieceValues[victim];
+            if (move.getFlag() == Move::PROMOTION)
+            {
+                gain += Evaluation::pieceValues[Position::QUEEN] - Evaluation::pieceValues[Position::PAWN];
+            }
+            if (standPat + gain + Search::DELTA_MARGIN <= alpha)
+            {
+                continue;
+            }
+
+            // a capture that loses material in the exchange that follows won't raise the stand pat score either
+            if (!Evaluation::see(position, move, 0))
+            {
+                continue;
+            }
+        }
+
+        Position::Undo undo;
+        position.makeMove(move, undo);
+        int score = -this->quiescence(worker, ply + 1, qply + 1, -beta, -alpha);
+        position.unmakeMove(move, undo);
+
+        if (this->isStopped())
+        {
+            return 0;
+        }
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            if (score > alpha)
+            {
+                alpha = score;
+                worker.pv[ply][0] = move;
+                for (int k = 0; k < worker.pvLength[ply + 1]; k++)
+                {
+                    worker.pv[ply][k + 1] = worker.pv[ply + 1][k];
+                }
+                worker.pvLength[ply] = worker.pvLength[ply + 1] + 1;
+            }
+        }
+        if (alpha >= beta)
+        {
+            break;
+        }
+    }
+    return bestScore;
+}
+
+void Search::scoreMoves(const Search::Worker& worker, const MoveList& moves, int ply, Move tableMove, int* scores) const
+{
+    // the move the table remembers first, the last depth's line next, then captures that don't lose material by most valuable
+    // victim and least valuable attacker, then killers, then the losing captures
+
+    const Position& position = worker.position;
+    Move pvMove = ply < worker.previousPvLength ? worker.previousPv[ply] : Move::none();
+
+    for (int i = 0; i < moves.size(); i++)
+    {
+        Move move = moves.moves[i];
+        int score = 0;
+        Position::PieceType victim = move.getFlag() == Move::EN_PASSANT ? Position::PAWN : position.getPieceTypeOn(move.getTo());
+        if (move == tableMove)
+        {
+            score = 1 << 21;
+        }
+        else if (move == pvMove)
+        {
+            score = 1 << 20;
+        }
+        else if (victim != Position::NO_PIECE_TYPE && move.getFlag() != Move::CASTLING)
+        {
+            int mvvLva = Evaluation::pieceValues[victim] * 16 - Evaluation::pieceValues[position.getPieceTypeOn(move.getFrom())] / 16;
+            score = (Evaluation::see(position, move, 0) ? 1 << 16 : 1 << 14) + mvvLva;
+        }
+        else if (move.getFlag() == Move::PROMOTION)
+        {
+            score = (1 << 16) + Evaluation::pieceValues[move.getPromotion()];
+        }
+        else if (move == worker.killers[ply][0])
+        {
+            score = (1 << 15) + 1;
+        }
+        else if (move == worker.killers[ply][1])
+        {
+            score = 1 << 15;
+        }
+        scores[i] = score;
+    }
+}
+
+bool Search::isOutOfBudget(const Search::Worker& worker)
+{
+    // only the main thread checks the limits, the clock and the other threads' counts only every 1024 nodes
+
+    if (this->isStopped())
+    {
+        return true;
+    }
+    if (worker.id > 0)
+    {
+        return false;
+    }
+    bool checkpoint = (worker.nodes.load(std::memory_order_relaxed) & 1023) == 0;
+    if ((this->limits.nodes > 0 && (checkpoint || this->workers.size() == 1) && this->getNodes() >= this->limits.nodes)
+        || (this->timeBudget > 0 && checkpoint && this->getClockElapsed() >= this->timeBudget))
+    {
+        this->stop();
+        return true;
+    }
+    return false;
+}
+
+uint64_t Search::getNodes() const
+{
+    uint64_t nodes = 0;
+    for (const std::unique_ptr<Search::Worker>& worker : this->workers)
+    {
+        nodes += worker->nodes.load(std::memory_order_relaxed);
+    }
+    return nodes;
+}
+
+int64_t Search::getClockElapsed() const
+{
+    if (this->pondering.load(std::memory_order_acquire))
+    {
+        return 0;
+    }
+    return Search::getNow() - this->clockStart.load(std::memory_order_relaxed);
+}
+
+int64_t Search::getNow()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t Search::getElapsed() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->startTime).count();
+}
+
+int64_t Search::getTimeBudget() const
+{
+    // a fixed move time is used whole, with a clock the time is spread over the moves still to come
+
+    if (this->limits.infinite)
+    {
+        return 0;
+    }
+    if (this->limits.moveTime > 0)
+    {
+        return this->limits.moveTime;
+    }
+
+    Position::Color us = (Position::Color)this->game.position.sideToMove;
+    int64_t left = this->limits.time[us];
+    if (left <= 0)
+    {
+        return 0;
+    }
+    int movesToGo = this->limits.movesToGo > 0 ? this->limits.movesToGo : 30;
+    int64_t budget = left / movesToGo + this->limits.increment[us] * 3 / 4;
+    int64_t ceiling = left - 50 < left / 2 ? left / 2 : left - 50; // some time for the gui to see the move
+    if (budget > ceiling)
+    {
+        budget = ceiling;
+    }
+    return budget > 1 ? budget : 1;
+}
@@ -0,0 +1,140 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "evaluation.h"
+#include "game.h"
+#include "transposition.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// picks a move for the side to move of a game with a negamax alpha-beta search, deepened one ply at a time
+// until one of its limits is hit or stop() is called
+// the search runs on a thread of its own, start returns at once so a front end stays responsive, think blocks
+// with more than one thread it is lazy smp: helpers search the same root at staggered depths and share
+// only the transposition table, which is what makes the main thread faster
+
+class Search
+{
+public:
+    static const int MAX_PLY = 128;
+    static const int INFINITE_SCORE = 32000;
+    static const int MATE_SCORE = 31000; // mate in n plies scores MATE_SCORE - n
+    static const int MAX_THREADS = 256;
+
+    // undoing every ply the game keeps and then searching a full line must not overwrite a slot a lookup still reads
+    static_assert(RepetitionHistory::SIZE >= Game::MAX_PLIES + Search::MAX_PLY + RepetitionHistory::MAX_REACH, "repetition history too small");
+
+    struct Limits // zero means no limit
+    {
+        int depth = 0;
+        uint64_t nodes = 0;
+        int64_t moveTime = 0; // milliseconds for this move
+        int64_t time[2] = { 0, 0 }; // milliseconds left on each clock, indexed by Position::Color
+        int64_t increment[2] = { 0, 0 };
+        int movesToGo = 0;
+        bool infinite = false; // only stop() ends it
+        bool ponder = false; // searches on the opponent's time, the clock limits only start with ponderhit()
+    };
+
+    struct Report // what the search found so far, sent after every finished depth
+    {
+        int depth;
+        int score; // centipawns from the side to move's point of view
+        uint64_t nodes;
+        int64_t milliseconds;
+        uint64_t nodesPerSecond;
+        Move pv[Search::MAX_PLY];
+        int pvLength;
+        int hashfull; // permille of the transposition table filled by this search
+        int threads;
+    };
+
+    using Reporter = std::function<void(const Search::Report&)>; // called from the search thread
+    using Finisher = std::function<void(Move best, Move ponder)>; // called from the search thread once it's done, Move::none() if there is no legal move or no reply to ponder on
+
+    Search();
+    ~Search();
+    Search(const Search&) = delete;
+    Search& operator=(const Search&) = delete;
+
+    void start(const Game& game, const Search::Limits& limits, Search::Reporter reporter = nullptr, Search::Finisher finisher = nullptr); // stops and waits for a search still running first
+    void stop() { this->stopRequested.store(true, std::memory_order_relaxed); }
+    void ponderhit(); // the pondered move was played, the search goes on under its time limits from now on; nothing if it isn't pondering
+    Move wait(); // blocks until the search is done and returns its move
+    Move think(const Game& game, const Search::Limits& limits, Search::Reporter reporter = nullptr) { this->start(game, limits, reporter); return this->wait(); }
+
+    // the table is kept from one search to the next, these stop a running search first
+    bool setHashSize(size_t megabytes, bool hugePages = false);
+    void clearHash();
+    bool isUsingHugePages() const { return this->table.isUsingHugePages(); }
+    size_t getHashSize() const { return this->table.getSize(); } // megabytes actually allocated
+    void setThreads(int count); // the calling thread is not counted, a search runs on count threads of its own
+    int getThreads() const { return (int)this->workers.size(); }
+    uint64_t getNodes() const; // every thread's nodes in the running or the last search
+
+    bool isSearching() const { return this->thread.joinable() && !this->finished.load(std::memory_order_acquire); }
+    bool isStopped() const { return this->stopRequested.load(std::memory_order_relaxed); }
+    bool isPondering() const { return this->pondering.load(std::memory_order_relaxed); }
+
+    static bool isMateScore(int score) { return score > Search::MATE_SCORE - Search::MAX_PLY || score < -Search::MATE_SCORE + Search::MAX_PLY; }
+
+    // a mate is scored from the root, the table keeps it relative to the node so it stays right wherever the node is found again
+    static int scoreToTable(int score, int ply) { return score > Search::MATE_SCORE - Search::MAX_PLY ? score + ply : (score < -Search::MATE_SCORE + Search::MAX_PLY ? score - ply : score); }
+    static int scoreFromTable(int score, int ply) { return score > Search::MATE_SCORE - Search::MAX_PLY ? score - ply : (score < -Search::MATE_SCORE + Search::MAX_PLY ? score + ply : score); }
+
+private:
+    struct Worker // everything a search thread changes while it searches
+    {
+        Position position;
+        RepetitionHistory history; // the game's positions followed by the ones on the current line
+        int id; // 0 is the main thread, the only one that reports and watches the clock
+        std::atomic<uint64_t> nodes; // read by the main thread while the worker writes it
+        int completedDepth;
+        int completedScore;
+        Move killers[Search::MAX_PLY][2]; // quiet moves that caused a cutoff at this ply, tried right after the captures
+        Move pv[Search::MAX_PLY][Search::MAX_PLY]; // triangular table, pv[ply] holds the best line found from that ply on
+        int pvLength[Search::MAX_PLY];
+        Move previousPv[Search::MAX_PLY]; // the line of the last finished depth, searched first
+        int previousPvLength;
+    };
+
+    std::thread thread;
+    std::vector<std::thread> helpers;
+    std::vector<std::unique_ptr<Search::Worker>> workers; // kept between searches, the pv tables are large
+    std::atomic<bool> stopRequested;
+    std::atomic<bool> finished;
+    std::atomic<bool> pondering;
+
+    // copies of what start was given, owned by the search thread while it runs
+    Game game;
+    Search::Limits limits;
+    Search::Reporter reporter;
+    Search::Finisher finisher;
+    Move bestMove;
+    Move ponderMove; // the reply the pv expects to bestMove
+    TranspositionTable table;
+
+    std::chrono::steady_clock::time_point startTime; // for the reports
+    std::atomic<int64_t> clockStart; // steady clock milliseconds the time budget counts from, moved by ponderhit
+    int64_t timeBudget; // milliseconds, 0 if only depth, nodes or stop end the search
+
+    static const int DELTA_MARGIN = 200; // centipawns a capture may gain beyond the captured piece through position
+
+    void run();
+    void iterate(Search::Worker& worker);
+    int negamax(Search::Worker& worker, int depth, int ply, int alpha, int beta);
+    int quiescence(Search::Worker& worker, int ply, int qply, int alpha, int beta);
+    void scoreMoves(const Search::Worker& worker, const MoveList& moves, int ply, Move tableMove, int* scores) const;
+    bool isOutOfBudget(const Search::Worker& worker);
+    int64_t getElapsed() const;
+    int64_t getClockElapsed() const; // 0 while pondering
+    static int64_t getNow();
+    int64_t getTimeBudget() const;
+    void report(const Search::Worker& worker, int depth, int score);
+};
+
+#endif
@@ -22,19 +22,14 @@ const float cellWidth = (windowWidth - boardSide) / 8;
 const float cellHeight = (windowHeight - boardSide) / 8;
 const float pieceScale = cellWidth / pieceTextureWidth;
 
-const uint8_t firstBlackIndex = 0;
-const uint8_t lastBlackIndex = 15;
-const uint8_t firstWhiteIndex = 48;
-const uint8_t lastWhiteIndex = 63;
-const uint8_t blackKingIndex = 3;
-const uint8_t whiteKingIndex = 60;
-
 extern std::vector<std::string> whitePieceOrder;
 extern std::vector<std::string> blackPieceOrder;
 extern std::vector<char> colorOrder;
 
-const std::string pathToPieceTextures = "res\\textures\\piece_textures";
-const std::string pathToOtherTextures = "res\\textures\\other_textures";
+const std::string pathToPieceTextures = "res/textures/piece_textures";
+const std::string pathToOtherTextures = "res/textures/other_textures";
 const std::string fileType = ".png";
 
+const int engineMoveTime = 1000; // milliseconds the engine thinks when space is pressed
+
 #endif
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "transposition.h"
+#include <climits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+TranspositionTable::TranspositionTable()
+{
+    this->buckets = nullptr;
+    this->bucketCount = 0;
+    this->allocatedBytes = 0;
+    this->generation = 0;
+    this->hugePages = false;
+    this->resize(TranspositionTable::DEFAULT_SIZE);
+}
+
+TranspositionTable::~TranspositionTable()
+{
+    this->release();
+}
+
+bool TranspositionTable::resize(size_t megabytes, bool hugePages)
+{
+    if (megabytes < 1)
+    {
+        megabytes = 1;
+    }
+    if (megabytes > TranspositionTable::MAX_SIZE)
+    {
+        megabytes = TranspositionTable::MAX_SIZE;
+    }
+
+    size_t bucketCount = 1;
+    while (bucketCount * 2 * sizeof(TranspositionTable::Bucket) <= (megabytes << 20))
+    {
+        bucketCount *= 2;
+    }
+    size_t bytes = bucketCount * sizeof(TranspositionTable::Bucket);
+    this->release();
+
+    // whole pages straight from the system, they come zeroed and aligned far past a cache line
+    void* memory = nullptr;
+    this->hugePages = false;
+#ifdef _WIN32
+    memory = VirtualAlloc(nullptr, bytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    if (hugePages && bytes >= (2 << 20)) // needs pages reserved through vm.nr_hugepages, from 2 MB on every table size is a multiple of 2 MB
+    {
+        memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory == MAP_FAILED)
+        {
+            memory = nullptr;
+        }
+        this->hugePages = memory != nullptr;
+    }
+#endif
+    if (memory == nullptr)
+    {
+        memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+        {
+            memory = nullptr;
+        }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        else if (hugePages) // transparent huge pages are the next best thing
+        {
+            madvise(memory, bytes, MADV_HUGEPAGE);
+        }
+#endif
+    }
+#endif
+    (void)hugePages;
+
+    if (memory == nullptr)
+    {
+        if (megabytes > 1)
+        {
+            this->resize(1, false); // a search without a table would still have to work
+        }
+        return false;
+    }
+    this->buckets = (TranspositionTable::Bucket*)memory;
+    this->bucketCount = bucketCount;
+    this->allocatedBytes = bytes;
+    this->clear(); // touches every page now instead of during the first search
+    return true;
+}
+
+void TranspositionTable::release()
+{
+    if (this->buckets == nullptr)
+    {
+        return;
+    }
+#ifdef _WIN32
+    VirtualFree(this->buckets, 0, MEM_RELEASE);
+#else
+    munmap(this->buckets, this->allocatedBytes);
+#endif
+    this->buckets = nullptr;
+    this->bucketCount = 0;
+    this->allocatedBytes = 0;
+}
+
+void TranspositionTable::clear()
+{
+    for (size_t i = 0; i < this->bucketCount; i++)
+    {
+        for (TranspositionTable::Slot& slot : this->buckets[i].slots)
+        {
+            slot.key.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    this->generation = 0;
+}
+
+bool TranspositionTable::probe(uint64_t hash, TranspositionTable::Entry& entry) const
+{
+    TranspositionTable::Bucket& bucket = this->getBucket(hash);
+    for (const TranspositionTable::Slot& slot : bucket.slots)
+    {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if ((slot.key.load(std::memory_order_relaxed) ^ data) != hash || data == 0)
+        {
+            continue;
+        }
+
+        entry.move.data = (uint16_t)data;
+        entry.score = (int16_t)(data >> 16);
+        entry.depth = TranspositionTable::getDepth(data);
+        entry.bound = (TranspositionTable::Bound)((data >> 40) & 3);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t hash, Move move, int score, int depth, TranspositionTable::Bound bound)
+{
+    // the same position is overwritten, otherwise the shallowest entry, with every search of age counting as 8 plies of depth
+
+    TranspositionTable::Bucket& bucket = this->getBucket(hash);
+    TranspositionTable::Slot* replace = &bucket.slots[0];
+    int replaceWorth = INT_MAX;
+    for (TranspositionTable::Slot& slot : bucket.slots)
+    {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if ((slot.key.load(std::memory_order_relaxed) ^ data) == hash && data != 0)
+        {
+            if (move == Move::none())
+            {
+                move.data = (uint16_t)data; // the position's best move is still worth keeping for ordering
+            }
+            replace = &slot;
+            break;
+        }
+        int age = (uint8_t)(this->generation - TranspositionTable::getGeneration(data));
+        int worth = data == 0 ? INT_MIN : TranspositionTable::getDepth(data) - 8 * age;
+        if (worth < replaceWorth)
+        {
+            replace = &slot;
+            replaceWorth = worth;
+        }
+    }
+
+    uint64_t data = TranspositionTable::pack(move, score, depth, bound, this->generation);
+    replace->key.store(hash ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::prefetch(uint64_t hash) const
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch((const char*)&this->getBucket(hash), _MM_HINT_T0);
+#elif defined(__GNUC__)
+    __builtin_prefetch(&this->getBucket(hash));
+#else
+    (void)hash;
+#endif
+}
+
+int TranspositionTable::getHashfull() const
+{
+    int used = 0;
+    for (size_t i = 0; i < 250 && i < this->bucketCount; i++)
+    {
+        for (const TranspositionTable::Slot& slot : this->buckets[i].slots)
+        {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            used += data != 0 && TranspositionTable::getGeneration(data) == this->generation;
+        }
+    }
+    return used;
+}
+
+uint64_t TranspositionTable::pack(Move move, int score, int depth, TranspositionTable::Bound bound, uint8_t generation)
+{
+    return (uint64_t)move.data | (uint64_t)(uint16_t)(int16_t)score << 16 | (uint64_t)(uint8_t)(int8_t)depth << 32
+        | (uint64_t)bound << 40 | (uint64_t)generation << 42;
+}
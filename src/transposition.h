@@ -0,0 +1,83 @@
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include "move.h"
+#include <atomic>
+#include <cstddef>
+
+// results of earlier searches keyed by zobrist hash, shared by every search thread without a lock
+// an entry is two words, the data and the key xored with the data: a write torn by another thread
+// leaves a key that no longer matches and the entry is simply missed
+
+class TranspositionTable
+{
+public:
+    enum Bound
+    {
+        NO_BOUND = 0,
+        UPPER_BOUND = 1, // every move failed low, the score is at most this
+        LOWER_BOUND = 2, // a move failed high, the score is at least this
+        EXACT_BOUND = 3
+    };
+
+    struct Entry // what a probe hands back, unpacked
+    {
+        Move move;
+        int score;
+        int depth;
+        TranspositionTable::Bound bound;
+    };
+
+    static const size_t DEFAULT_SIZE = 16; // megabytes
+    static const size_t MAX_SIZE = 65536;
+
+    TranspositionTable();
+    ~TranspositionTable();
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    // not safe while a search runs, the size is rounded down to a power of two buckets
+    // huge pages are only tried on Linux, if none can be had the table falls back to normal pages
+    // false if the size asked for couldn't be allocated, the table is then 1 MB so a search still works, see getSize
+    bool resize(size_t megabytes, bool hugePages = false);
+    void clear();
+    void newSearch() { this->generation = (uint8_t)(this->generation + 1); } // older entries get replaced first
+
+    // scores are stored as given, the search makes mate scores relative to the node before storing them
+    bool probe(uint64_t hash, TranspositionTable::Entry& entry) const;
+    void store(uint64_t hash, Move move, int score, int depth, TranspositionTable::Bound bound);
+    void prefetch(uint64_t hash) const;
+
+    int getHashfull() const; // permille of the entries in the first 250 buckets (1000 entries) written in this search, for uci
+    size_t getSize() const { return this->bucketCount * sizeof(TranspositionTable::Bucket) >> 20; }
+    bool isUsingHugePages() const { return this->hugePages; }
+
+private:
+    static const int BUCKET_SIZE = 4; // 4 entries of 16 bytes fill a cache line
+
+    struct Slot
+    {
+        std::atomic<uint64_t> key; // hash ^ data
+        std::atomic<uint64_t> data; // bits 0-15 move, 16-31 score, 32-39 depth, 40-41 bound, 42-49 generation
+    };
+
+    struct alignas(64) Bucket
+    {
+        TranspositionTable::Slot slots[TranspositionTable::BUCKET_SIZE];
+    };
+
+    TranspositionTable::Bucket* buckets;
+    size_t bucketCount; // a power of two
+    size_t allocatedBytes;
+    uint8_t generation;
+    bool hugePages;
+
+    TranspositionTable::Bucket& getBucket(uint64_t hash) const { return this->buckets[hash & (this->bucketCount - 1)]; }
+    void release();
+
+    static uint64_t pack(Move move, int score, int depth, TranspositionTable::Bound bound, uint8_t generation);
+    static int getDepth(uint64_t data) { return (int)(int8_t)(data >> 32); }
+    static uint8_t getGeneration(uint64_t data) { return (uint8_t)(data >> 42); }
+};
+
+#endif
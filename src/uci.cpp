@@ -0,0 +1,371 @@
+#include "uci.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+Uci::Uci()
+{
+    this->hashSize = TranspositionTable::DEFAULT_SIZE;
+    this->largePages = false;
+    this->game.startingPosition();
+}
+
+Uci::~Uci()
+{
+    this->stopSearch();
+}
+
+void Uci::run()
+{
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        std::istringstream input(line);
+        std::string command;
+        input >> command;
+
+        if (command == "uci")
+        {
+            this->handleUci();
+        }
+        else if (command == "isready")
+        {
+            this->send("readyok");
+        }
+        else if (command == "ucinewgame")
+        {
+            this->stopSearch();
+            this->search.clearHash();
+            this->game.startingPosition();
+        }
+        else if (command == "position")
+        {
+            this->stopSearch();
+            this->handlePosition(input);
+        }
+        else if (command == "go")
+        {
+            this->stopSearch();
+            this->handleGo(input);
+        }
+        else if (command == "ponderhit")
+        {
+            this->search.ponderhit();
+        }
+        else if (command == "stop")
+        {
+            this->search.stop(); // the search thread answers with bestmove
+        }
+        else if (command == "setoption")
+        {
+            this->stopSearch();
+            this->handleSetOption(input);
+        }
+        else if (command == "bench") // not uci, measures how the search scales with threads
+        {
+            this->stopSearch();
+            this->handleBench(input);
+        }
+        else if (command == "d") // not uci, prints the current position
+        {
+            char fen[Position::MAX_FEN_LENGTH];
+            this->game.getFen(fen);
+            this->send(std::string("info string ") + fen);
+        }
+        else if (command == "quit")
+        {
+            break;
+        }
+        else if (!command.empty() && command != "debug" && command != "register")
+        {
+            this->send("info string unknown command " + command);
+        }
+    }
+    this->stopSearch();
+}
+
+void Uci::send(const std::string& line)
+{
+    std::lock_guard<std::mutex> lock(this->outputMutex);
+    std::cout << line << std::endl;
+}
+
+void Uci::stopSearch()
+{
+    this->search.stop();
+    this->search.wait();
+}
+
+void Uci::handleUci()
+{
+    this->send("id name chess_rebuild");
+    this->send("id author chess_rebuild");
+    this->send("option name Hash type spin default " + std::to_string(TranspositionTable::DEFAULT_SIZE) + " min 1 max " + std::to_string(TranspositionTable::MAX_SIZE));
+    this->send("option name Large Pages type check default false");
+    this->send("option name Clear Hash type button");
+    this->send("option name Ponder type check default false");
+    this->send("option name Threads type spin default 1 min 1 max " + std::to_string(Search::MAX_THREADS));
+    this->send("uciok");
+}
+
+void Uci::handlePosition(std::istringstream& input)
+{
+    // position startpos|fen <fen> [moves <move>...], a bad fen or move keeps what came before it
+
+    std::string token;
+    input >> token;
+    if (token == "startpos")
+    {
+        this->game.startingPosition();
+        input >> token;
+    }
+    else if (token == "fen")
+    {
+        std::string fen;
+        while (input >> token && token != "moves")
+        {
+            fen += fen.empty() ? token : " " + token;
+        }
+        if (!this->game.loadFen(fen.c_str()))
+        {
+            this->send("info string invalid fen " + fen);
+            return;
+        }
+    }
+    else
+    {
+        return;
+    }
+
+    if (token != "moves")
+    {
+        return;
+    }
+    while (input >> token)
+    {
+        Move move;
+        if (!Notation::parseUci(this->game.position, token.c_str(), (int)token.size(), move))
+        {
+            this->send("info string illegal move " + token);
+            return;
+        }
+        this->game.makeMove(move);
+    }
+}
+
+void Uci::handleGo(std::istringstream& input)
+{
+    Search::Limits limits;
+    std::string token;
+    while (input >> token)
+    {
+        if (token == "wtime")
+        {
+            input >> limits.time[Position::WHITE];
+        }
+        else if (token == "btime")
+        {
+            input >> limits.time[Position::BLACK];
+        }
+        else if (token == "winc")
+        {
+            input >> limits.increment[Position::WHITE];
+        }
+        else if (token == "binc")
+        {
+            input >> limits.increment[Position::BLACK];
+        }
+        else if (token == "movestogo")
+        {
+            input >> limits.movesToGo;
+        }
+        else if (token == "depth")
+        {
+            input >> limits.depth;
+        }
+        else if (token == "nodes")
+        {
+            input >> limits.nodes;
+        }
+        else if (token == "movetime")
+        {
+            input >> limits.moveTime;
+        }
+        else if (token == "infinite")
+        {
+            limits.infinite = true;
+        }
+        else if (token == "ponder")
+        {
+            limits.ponder = true;
+        }
+    }
+
+    // the search copies the game, the next position command can't change it under the search thread
+    this->search.start(this->game, limits,
+        [this](const Search::Report& report) { this->report(report); },
+        [this](Move best, Move ponder) { this->send("bestmove " + Uci::moveToString(best) + (ponder == Move::none() ? "" : " ponder " + Uci::moveToString(ponder))); });
+}
+
+void Uci::handleSetOption(std::istringstream& input)
+{
+    // setoption name <name> [value <value>], names may hold spaces
+
+    std::string token;
+    std::string name;
+    std::string value;
+    input >> token;
+    while (input >> token && token != "value")
+    {
+        name += name.empty() ? token : " " + token;
+    }
+    while (input >> token)
+    {
+        value += value.empty() ? token : " " + token;
+    }
+
+    if (name == "Hash" || name == "Large Pages")
+    {
+        // the table only comes in powers of two, anything else is rounded down and what was allocated is reported
+        if (name == "Hash")
+        {
+            this->hashSize = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else
+        {
+            this->largePages = value == "true";
+        }
+        if (!this->search.setHashSize(this->hashSize, this->largePages))
+        {
+            this->send("info string could not allocate " + std::to_string(this->hashSize) + " MB for the hash table, using "
+                + std::to_string(this->search.getHashSize()) + " MB");
+        }
+        else if (this->search.getHashSize() != this->hashSize)
+        {
+            this->send("info string hash table set to " + std::to_string(this->search.getHashSize()) + " MB, the size is rounded down to a power of two from 1 to "
+                + std::to_string(TranspositionTable::MAX_SIZE) + " MB");
+        }
+        if (this->largePages && !this->search.isUsingHugePages())
+        {
+            this->send("info string large pages not available, using normal pages");
+        }
+    }
+    else if (name == "Threads")
+    {
+        this->search.setThreads(std::atoi(value.c_str()));
+    }
+    else if (name == "Ponder")
+    {
+        // nothing to set, a gui only sends go ponder when this is on
+    }
+    else if (name == "Clear Hash")
+    {
+        this->search.clearHash();
+    }
+    else
+    {
+        this->send("info string unknown option " + name);
+    }
+}
+
+void Uci::handleBench(std::istringstream& input)
+{
+    // bench [depth] [most threads]
+    // every position is searched to the same depth from an empty table with 1, 2, 4... threads, the thread count set before
+    // is restored after; time to depth is what lazy smp buys, nps alone only shows that the threads are busy
+
+    const char* fens[] =
+    {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r1bq1rk1/pp2bppp/2n1pn2/2pp4/3P4/2PBPN2/PP1N1PPP/R1BQ1RK1 w - - 0 8",
+        "r2q1rk1/1b1nbppp/p2ppn2/1p6/3NP3/1BN1B3/PPP1QPPP/R4RK1 w - - 0 11",
+        "2r2rk1/pp1bqpp1/2n1p2p/3pP3/3P4/P1PB1N2/5PPP/R2Q1RK1 w - - 1 17",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "6k1/5pp1/p3p2p/1p1r4/3P4/P3R1P1/5P1P/6K1 b - - 0 32",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"
+    };
+
+    int depth = 8;
+    int mostThreads = (int)std::thread::hardware_concurrency();
+    input >> depth >> mostThreads;
+    depth = depth < 1 ? 1 : (depth > Search::MAX_PLY - 1 ? Search::MAX_PLY - 1 : depth);
+    mostThreads = mostThreads < 1 ? 1 : (mostThreads > Search::MAX_THREADS ? Search::MAX_THREADS : mostThreads);
+
+    int threadsBefore = this->search.getThreads();
+    double baseSeconds = 0.0;
+    uint64_t baseNodesPerSecond = 0;
+    for (int threads = 1; ; threads = threads * 2 < mostThreads ? threads * 2 : mostThreads)
+    {
+        this->search.setThreads(threads);
+        uint64_t nodes = 0;
+        double seconds = 0.0;
+        for (const char* fen : fens)
+        {
+            Game game;
+            game.loadFen(fen);
+            this->search.clearHash();
+
+            // the whole search on the wall clock and every node of it, the unfinished last iteration of a helper included
+            Search::Limits limits;
+            limits.depth = depth;
+            auto start = std::chrono::steady_clock::now();
+            this->search.think(game, limits);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            nodes += this->search.getNodes();
+        }
+
+        uint64_t nodesPerSecond = (uint64_t)((double)nodes / (seconds > 0.0 ? seconds : 1e-9));
+        if (threads == 1)
+        {
+            baseSeconds = seconds;
+            baseNodesPerSecond = nodesPerSecond;
+        }
+        char line[200];
+        std::snprintf(line, sizeof(line), "info string threads %d depth %d time %.0f ms nodes %llu nps %llu time to depth speedup %.2f nps speedup %.2f",
+            threads, depth, seconds * 1000.0, (unsigned long long)nodes, (unsigned long long)nodesPerSecond,
+            baseSeconds / (seconds > 0.0 ? seconds : 1e-9), (double)nodesPerSecond / (double)(baseNodesPerSecond > 0 ? baseNodesPerSecond : 1));
+        this->send(line);
+
+        if (threads == mostThreads)
+        {
+            break;
+        }
+    }
+    this->search.setThreads(threadsBefore);
+}
+
+void Uci::report(const Search::Report& report)
+{
+    std::string line = "info depth " + std::to_string(report.depth) + " score " + Uci::scoreToString(report.score)
+        + " nodes " + std::to_string(report.nodes) + " nps " + std::to_string(report.nodesPerSecond) + " hashfull " + std::to_string(report.hashfull)
+        + " time " + std::to_string(report.milliseconds) + " pv";
+    for (int i = 0; i < report.pvLength; i++)
+    {
+        line += " " + Uci::moveToString(report.pv[i]);
+    }
+    this->send(line);
+}
+
+std::string Uci::moveToString(Move move)
+{
+    if (move == Move::none())
+    {
+        return "0000";
+    }
+    char text[Notation::MAX_UCI_LENGTH];
+    Notation::toUci(move, text);
+    return text;
+}
+
+std::string Uci::scoreToString(int score)
+{
+    if (!Search::isMateScore(score))
+    {
+        return "cp " + std::to_string(score);
+    }
+    int plies = Search::MATE_SCORE - (score > 0 ? score : -score);
+    int moves = (plies + 1) / 2;
+    return "mate " + std::to_string(score > 0 ? moves : -moves);
+}
@@ -0,0 +1,43 @@
+#ifndef UCI_H
+#define UCI_H
+
+#include "notation.h"
+#include "search.h"
+#include <mutex>
+#include <sstream>
+#include <string>
+
+// speaks the uci protocol over stdin and stdout
+// the thread that calls run only reads and answers commands, every search runs on a thread of its own,
+// so stop and isready are answered right away however long the search takes
+
+class Uci
+{
+public:
+    Uci();
+    ~Uci();
+
+    void run(); // until quit or the end of the input
+
+private:
+    Game game;
+    Search search;
+    size_t hashSize; // megabytes, kept so the two table options can be set in any order
+    bool largePages;
+    std::mutex outputMutex;
+
+    void send(const std::string& line); // whole lines only, the search thread writes too
+    void stopSearch(); // waits until the search thread has sent its bestmove
+
+    void handleUci();
+    void handlePosition(std::istringstream& input);
+    void handleGo(std::istringstream& input);
+    void handleSetOption(std::istringstream& input);
+    void handleBench(std::istringstream& input);
+    void report(const Search::Report& report);
+
+    static std::string moveToString(Move move);
+    static std::string scoreToString(int score);
+};
+
+#endif
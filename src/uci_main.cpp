@@ -0,0 +1,12 @@
+#include "uci.h"
+
+// headless uci engine, for chess guis and tournament managers
+
+int main()
+{
+    Attacks::init();
+
+    Uci uci;
+    uci.run();
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include "zobrist.h"
+
+uint64_t Zobrist::compute(const Position& position)
+{
+    uint64_t hash = 0;
+
+    for (uint8_t color = Position::WHITE; color <= Position::BLACK; color++)
+    {
+        for (uint8_t type = Position::ROOK; type < Position::NO_PIECE_TYPE; type++)
+        {
+            uint64_t pieces = position.pieces[color][type];
+            while (pieces)
+            {
+                hash ^= Zobrist::keys.pieces[color][type][Position::popLsb(pieces)];
+            }
+        }
+    }
+
+    hash ^= Zobrist::keys.castling[position.castlingRights];
+    if (position.enpassantSquare != Position::NO_SQUARE)
+    {
+        hash ^= Zobrist::keys.enpassantFile[Position::getFile(position.enpassantSquare)];
+    }
+    if (position.sideToMove == Position::BLACK)
+    {
+        hash ^= Zobrist::keys.blackToMove;
+    }
+    return hash;
+}
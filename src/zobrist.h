@@ -0,0 +1,63 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "position.h"
+
+// random keys for zobrist hashing, made by the compiler from a fixed seed so every build hashes the same way
+
+class ZobristKeys
+{
+public:
+    struct Table
+    {
+        uint64_t pieces[2][6][64];
+        uint64_t castling[16]; // one per combination of castling rights
+        uint64_t enpassantFile[8];
+        uint64_t blackToMove;
+    };
+
+    static constexpr uint64_t splitMix(uint64_t& state)
+    {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t value = state;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    static constexpr ZobristKeys::Table build(uint64_t seed)
+    {
+        ZobristKeys::Table table{};
+        for (auto& color : table.pieces)
+        {
+            for (auto& type : color)
+            {
+                for (uint64_t& key : type)
+                {
+                    key = ZobristKeys::splitMix(seed);
+                }
+            }
+        }
+        for (uint64_t& key : table.castling)
+        {
+            key = ZobristKeys::splitMix(seed);
+        }
+        table.castling[0] = 0; // no rights, no key
+        for (uint64_t& key : table.enpassantFile)
+        {
+            key = ZobristKeys::splitMix(seed);
+        }
+        table.blackToMove = ZobristKeys::splitMix(seed);
+        return table;
+    }
+};
+
+class Zobrist
+{
+public:
+    static constexpr ZobristKeys::Table keys = ZobristKeys::build(0x5A0B215ULL);
+
+    static uint64_t compute(const Position& position); // from scratch, walks every piece
+};
+
+#endif